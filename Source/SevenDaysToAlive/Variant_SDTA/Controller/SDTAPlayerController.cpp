@@ -11,6 +11,7 @@
 #include "Variant_SDTA/Components/HealthComponent.h"
 #include "Variant_SDTA/Core/Game/SDTAGameState.h"
 #include "Variant_SDTA/Core/Game/SDTAPlayerState.h"
+#include "Variant_SDTA/Core/Game/DayNight/SDTAEnvironmentRegistry.h"
 #include "SevenDaysToAlive.h"
 #include "Widgets/Input/SVirtualJoystick.h"
 #include "Components/LightComponent.h"
@@ -151,6 +152,14 @@ void ASDTAPlayerController::HandleDashInput()
  */
 void ASDTAPlayerController::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
+	// 解绑昼夜过渡状态变化事件
+	if (ASDTAGameState* GameState = GetSDTAGameState())
+	{
+		GameState->OnDayNightTransitionStateChanged.Remove(DayNightTransitionHandle);
+	}
+	DayNightTransitionHandle.Reset();
+	bClientEnvironmentBound = false;
+
 	// 调用父类的EndPlay方法
 	Super::EndPlay(EndPlayReason);
 }
@@ -266,11 +275,8 @@ void ASDTAPlayerController::Tick(float DeltaSeconds)
 		ASDTAGameState* GameState = GetSDTAGameState();
 		if (GameState)
 		{
-			// 更新昼夜和天数
-			PlayerHUD->bIsNight = GameState->bIsNight;
+			// 更新天数
 			PlayerHUD->CurrentDay = GameState->CurrentDay;
-			PlayerHUD->RemainingTime = GameState->RemainingTime;
-			PlayerHUD->TimePercent = GameState->TimePercent;
 			
 			// 从PlayerState获取玩家个人数据
 			ASDTAPlayerState* SDTAPlayerState = GetSDTAPlayerState();
@@ -285,16 +291,27 @@ void ASDTAPlayerController::Tick(float DeltaSeconds)
 				PlayerHUD->SoulFragments = GameState->GlobalSoulFragments;
 			}
 			
-			// 触发UI更新
-			PlayerHUD->BP_UpdateDayNightCycle(GameState->bIsNight, GameState->CurrentDay, GameState->RemainingTime, GameState->TimePercent);
+			// 根据复制的阶段时间锚点在本地计算剩余时间并触发昼夜UI更新
+			UpdateLocalTiming(DeltaSeconds);
 			PlayerHUD->BP_UpdateSoulFragments();
 		}
 	}
 
-	// 客户端环境同步
-	if (IsLocalPlayerController())
+	// 客户端环境同步：由过渡状态变化事件驱动，只有过渡进行中才每帧插值
+	// 服务器上的光源由昼夜管理器更新
+	if (IsLocalPlayerController() && GetNetMode() == NM_Client)
 	{
-		UpdateClientEnvironment();
+		if (!bClientEnvironmentBound)
+		{
+			BindClientEnvironment();
+		}
+
+		// 曲线驱动时光照随整个循环连续变化，每帧求值一次
+		const ASDTAGameState* GameState = GetSDTAGameState();
+		if (bClientEnvironmentTransitionActive || (GameState && GameState->LightingProfile.HasCurves()))
+		{
+			UpdateClientEnvironment();
+		}
 	}
 }
 
@@ -352,7 +369,8 @@ void ASDTAPlayerController::StartLocalTiming(bool InIsNightPhase, float TotalDur
  * 
  * 功能：每帧更新本地计时，用于昼夜循环进度条
  * 实现细节：
- * - 累加已用时间
+ * - GameState可用时根据复制的阶段、时间锚点和时长直接计算已用时间，不依赖服务器每帧复制剩余时间
+ * - 没有GameState时（StartLocalTiming手动开始的计时）累加已用时间
  * - 计算剩余时间和百分比
  * - 更新HUD的属性
  * - 触发UI更新
@@ -361,16 +379,26 @@ void ASDTAPlayerController::StartLocalTiming(bool InIsNightPhase, float TotalDur
  */
 void ASDTAPlayerController::UpdateLocalTiming(float DeltaTime)
 {
+	if (const ASDTAGameState* GameState = GetSDTAGameState())
+	{
+		// 从阶段时间锚点推算，与服务器的阶段边界保持一致
+		bIsNightPhase = GameState->bIsNight;
+		TotalPhaseDuration = GameState->GetPhaseDuration();
+		ElapsedPhaseTime = GameState->GetPhaseElapsedTime();
+	}
+	else
+	{
+		// 累加已用时间，确保不超过总持续时间
+		ElapsedPhaseTime += DeltaTime;
+		ElapsedPhaseTime = FMath::Min(ElapsedPhaseTime, TotalPhaseDuration);
+	}
+	
 	// 如果总持续时间为0，直接返回
 	if (TotalPhaseDuration <= 0.0f)
 	{
 		return;
 	}
 	
-	// 累加已用时间，确保不超过总持续时间
-	ElapsedPhaseTime += DeltaTime;
-	ElapsedPhaseTime = FMath::Min(ElapsedPhaseTime, TotalPhaseDuration);
-	
 	// 计算剩余时间和百分比
 	float RemainingTime = GetRemainingTime();
 	float TimePercent = CalculateTimePercent();
@@ -404,7 +432,7 @@ float ASDTAPlayerController::GetRemainingTime() const
  * 
  * 功能：计算当前阶段的时间百分比，用于进度条
  * 
- * @return 时间百分比（0.0-1.0）
+ * @return 剩余时间占阶段持续时间的比例（1.0-0.0），与服务器昼夜管理器一致
  */
 float ASDTAPlayerController::CalculateTimePercent() const
 {
@@ -413,7 +441,7 @@ float ASDTAPlayerController::CalculateTimePercent() const
 		return 0.0f;
 	}
 	
-	return ElapsedPhaseTime / TotalPhaseDuration;
+	return FMath::Clamp(GetRemainingTime() / TotalPhaseDuration, 0.0f, 1.0f);
 }
 
 /**
@@ -426,29 +454,70 @@ USDTAPlayerHUD* ASDTAPlayerController::GetPlayerHUD() const
 	return PlayerHUD;
 }
 
+/**
+ * 绑定GameState的昼夜过渡状态变化事件
+ * 
+ * 功能：GameState复制到客户端后绑定事件，并立即应用一次当前状态
+ */
+void ASDTAPlayerController::BindClientEnvironment()
+{
+	ASDTAGameState* GameState = GetSDTAGameState();
+	if (!GameState)
+	{
+		return;
+	}
+
+	DayNightTransitionHandle = GameState->OnDayNightTransitionStateChanged.AddUObject(this, &ASDTAPlayerController::HandleDayNightTransitionStateChanged);
+	bClientEnvironmentBound = true;
+
+	HandleDayNightTransitionStateChanged();
+}
+
+/**
+ * 昼夜过渡状态变化回调
+ * 
+ * 功能：强制应用一次当前状态（期间可能有新的光源加入），过渡中时开始本地插值
+ */
+void ASDTAPlayerController::HandleDayNightTransitionStateChanged()
+{
+	ASDTAGameState* GameState = GetSDTAGameState();
+	if (!GameState)
+	{
+		return;
+	}
+
+	bHasAppliedClientEnvironment = false;
+	bClientEnvironmentTransitionActive = GameState->bIsTransitioning;
+	UpdateClientEnvironment();
+}
+
 /**
  * 客户端环境同步方法
  * 用于在客户端根据GameState更新昼夜环境效果
  */
 void ASDTAPlayerController::UpdateClientEnvironment()
 {
-	// 获取GameState
+	// 获取GameState和环境注册表
 	ASDTAGameState* GameState = GetSDTAGameState();
-	if (!GameState || !GetWorld())
+	USDTAEnvironmentRegistry* Registry = USDTAEnvironmentRegistry::Get(this);
+	if (!GameState || !Registry)
 	{
 		return;
 	}
 
-	// 获取昼夜状态和过渡状态
+	// 获取昼夜状态和过渡状态，过渡进度根据过渡开始时间在本地计算
 	bool bIsNight = GameState->bIsNight;
-	bool bIsTransitioning = GameState->bIsTransitioning;
+	bool bIsTransitioning = GameState->bIsTransitioning && bClientEnvironmentTransitionActive;
 	bool bTransitionToNight = GameState->bTransitionToNight;
-	float TransitionProgress = GameState->TransitionProgress;
+	float TransitionProgress = GameState->GetLocalTransitionProgress();
 
-	// 1. 更新光源
-	TArray<AActor*> LightActors;
-	UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("WorldLight"), LightActors);
+	// 本地插值到达终点后停止每帧更新
+	if (TransitionProgress >= 1.0f)
+	{
+		bClientEnvironmentTransitionActive = false;
+	}
 
+	// 1. 计算光源目标值
 	// 从GameState获取光源配置
 	float DayLightIntensity = GameState->DayLightIntensity;
 	float NightLightIntensity = GameState->NightLightIntensity;
@@ -477,27 +546,7 @@ void ASDTAPlayerController::UpdateClientEnvironment()
 		TargetColor = bIsNight ? NightLightColor : DayLightColor;
 	}
 
-	// 更新所有光源
-	for (AActor* Actor : LightActors)
-	{
-		if (!Actor) continue;
-
-		TArray<ULightComponent*> LightComponents;
-		Actor->GetComponents<ULightComponent>(LightComponents);
-
-		for (ULightComponent* Light : LightComponents)
-		{
-			if (Light)
-			{
-				Light->SetIntensity(TargetIntensity);
-				Light->SetLightColor(TargetColor);
-			}
-		}
-	}
-
-	// 2. 更新大气效果
-	TArray<AActor*> AtmosphereActors;
-	UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("WorldAtmosphere"), AtmosphereActors);
+	// 2. 计算大气目标值
 
 	// 从GameState获取大气配置
 	FLinearColor DayAtmosphereColor = GameState->DayAtmosphereColor;
@@ -520,21 +569,51 @@ void ASDTAPlayerController::UpdateClientEnvironment()
 		TargetAtmosphereColor = bIsNight ? NightAtmosphereColor : DayAtmosphereColor;
 	}
 
-	// 更新所有大气组件
-	for (AActor* Actor : AtmosphereActors)
+	// 3. 按GameState复制的光照配置对曲线求值（未配置曲线的通道保留上面的插值结果）
+	const FSDTADayNightLightingProfile& LightingProfile = GameState->LightingProfile;
+	const float CycleProgress = GameState->GetCycleProgress();
+
+	FSDTADayNightLightingState Lighting;
+	Lighting.LightIntensity = TargetIntensity;
+	Lighting.LightColor = TargetColor;
+	Lighting.AtmosphereColor = TargetAtmosphereColor;
+	Lighting = LightingProfile.Evaluate(CycleProgress, Lighting);
+
+	TargetIntensity = Lighting.LightIntensity;
+	TargetColor = Lighting.LightColor;
+	TargetAtmosphereColor = Lighting.AtmosphereColor;
+
+	// 更新所有光源：配置了材质参数集合时只写一次全局参数，否则遍历注册表缓存的组件列表（数值未变化时跳过）
+	const bool bWroteParameters = LightingProfile.WriteParameters(GetWorld(), Lighting, CycleProgress);
+	if (!bWroteParameters && (!bHasAppliedClientEnvironment || !FMath::IsNearlyEqual(TargetIntensity, LastAppliedLightIntensity) || !TargetColor.Equals(LastAppliedLightColor)))
 	{
-		if (!Actor) continue;
+		for (const TWeakObjectPtr<ULightComponent>& Light : Registry->GetLights(FName("WorldLight")))
+		{
+			if (ULightComponent* LightComp = Light.Get())
+			{
+				LightComp->SetIntensity(TargetIntensity);
+				LightComp->SetLightColor(TargetColor);
+			}
+		}
 
-		TArray<UActorComponent*> Components;
-		Actor->GetComponents(USkyAtmosphereComponent::StaticClass(), Components);
+		LastAppliedLightIntensity = TargetIntensity;
+		LastAppliedLightColor = TargetColor;
+	}
 
-		for (UActorComponent* Component : Components)
+	// 更新所有大气组件（数值未变化时跳过）
+	if (!bHasAppliedClientEnvironment || !TargetAtmosphereColor.Equals(LastAppliedAtmosphereColor))
+	{
+		for (const TWeakObjectPtr<USkyAtmosphereComponent>& Atmosphere : Registry->GetAtmospheres(FName("WorldAtmosphere")))
 		{
-			if (USkyAtmosphereComponent* AtmosphereComp = Cast<USkyAtmosphereComponent>(Component))
+			if (USkyAtmosphereComponent* AtmosphereComp = Atmosphere.Get())
 			{
 				AtmosphereComp->RayleighScattering = TargetAtmosphereColor;
 			}
 		}
+
+		LastAppliedAtmosphereColor = TargetAtmosphereColor;
 	}
+
+	bHasAppliedClientEnvironment = true;
 }
 
@@ -125,7 +125,28 @@ public:
 private:
 	/**
 	 * 客户端环境同步方法
-	 * 用于在客户端根据GameState更新昼夜环境效果
+	 * 用于在客户端根据GameState更新昼夜环境效果，数值未变化时不修改光源
 	 */
 	void UpdateClientEnvironment();
+
+	/** 绑定GameState的昼夜过渡状态变化事件（GameState复制到客户端后才能绑定） */
+	void BindClientEnvironment();
+
+	/** 昼夜过渡状态变化回调：立即应用一次当前状态，过渡中时开始本地插值 */
+	void HandleDayNightTransitionStateChanged();
+
+	/** 是否已绑定过渡状态变化事件 */
+	bool bClientEnvironmentBound = false;
+
+	/** 是否正在本地插值过渡（只有此时才在Tick中更新环境） */
+	bool bClientEnvironmentTransitionActive = false;
+
+	/** 上次应用到光源和大气的数值，未变化时跳过渲染状态更新 */
+	bool bHasAppliedClientEnvironment = false;
+	float LastAppliedLightIntensity = 0.0f;
+	FLinearColor LastAppliedLightColor = FLinearColor::Black;
+	FLinearColor LastAppliedAtmosphereColor = FLinearColor::Black;
+
+	/** 过渡状态变化事件句柄 */
+	FDelegateHandle DayNightTransitionHandle;
 };
\ No newline at end of file
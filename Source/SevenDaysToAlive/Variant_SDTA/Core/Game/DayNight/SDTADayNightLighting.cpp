@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTADayNightLighting.cpp - 昼夜光照配置实现文件
+ *
+ * 实现细节：
+ * - 写入参数时直接访问世界中的集合实例，参数名不存在时集合实例只输出一次警告
+ */
+
+#include "Variant_SDTA/Core/Game/DayNight/SDTADayNightLighting.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "Engine/World.h"
+
+bool FSDTADayNightLightingProfile::HasCurves() const
+{
+	return LightIntensityCurve || LightColorCurve || AtmosphereColorCurve;
+}
+
+/**
+ * 按昼夜循环进度求值
+ *
+ * @param CycleProgress 昼夜循环进度（0-1）
+ * @param Fallback 未配置曲线的通道使用的数值
+ * @return 光照数值
+ */
+FSDTADayNightLightingState FSDTADayNightLightingProfile::Evaluate(float CycleProgress, const FSDTADayNightLightingState& Fallback) const
+{
+	FSDTADayNightLightingState State = Fallback;
+
+	if (LightIntensityCurve)
+	{
+		State.LightIntensity = LightIntensityCurve->GetFloatValue(CycleProgress);
+	}
+
+	if (LightColorCurve)
+	{
+		State.LightColor = LightColorCurve->GetLinearColorValue(CycleProgress);
+	}
+
+	if (AtmosphereColorCurve)
+	{
+		State.AtmosphereColor = AtmosphereColorCurve->GetLinearColorValue(CycleProgress);
+	}
+
+	return State;
+}
+
+/**
+ * 把光照数值写入材质参数集合
+ *
+ * @param World 世界
+ * @param State 光照数值
+ * @param CycleProgress 昼夜循环进度（0-1）
+ * @return 写入成功时返回true，未配置集合时返回false
+ */
+bool FSDTADayNightLightingProfile::WriteParameters(UWorld* World, const FSDTADayNightLightingState& State, float CycleProgress) const
+{
+	if (!World || !ParameterCollection)
+	{
+		return false;
+	}
+
+	UMaterialParameterCollectionInstance* Instance = World->GetParameterCollectionInstance(ParameterCollection);
+	if (!Instance)
+	{
+		return false;
+	}
+
+	Instance->SetScalarParameterValue(LightIntensityParameter, State.LightIntensity);
+	Instance->SetVectorParameterValue(LightColorParameter, State.LightColor);
+	Instance->SetVectorParameterValue(AtmosphereColorParameter, State.AtmosphereColor);
+	Instance->SetScalarParameterValue(CycleProgressParameter, CycleProgress);
+	return true;
+}
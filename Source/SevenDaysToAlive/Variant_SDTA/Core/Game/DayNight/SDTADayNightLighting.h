@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SDTADayNightLighting.generated.h"
+
+class UCurveFloat;
+class UCurveLinearColor;
+class UMaterialParameterCollection;
+
+/**
+ * 昼夜光照数值（一次求值的结果）
+ */
+struct FSDTADayNightLightingState
+{
+	float LightIntensity = 0.0f; // 光源亮度
+	FLinearColor LightColor = FLinearColor::White; // 光源颜色
+	FLinearColor AtmosphereColor = FLinearColor::White; // 大气瑞利散射颜色
+};
+
+/**
+ * 昼夜光照配置
+ *
+ * 核心功能：
+ * 1. 用曲线描述一整个昼夜循环中的光源亮度、光源颜色和大气颜色，曲线横轴为循环进度（0-1，0为白天开始）
+ * 2. 每帧求值一次，结果写入一个材质参数集合（MPC），材质和天空读取全局参数，不再逐个修改带标签的光源
+ *
+ * 设计要点：
+ * - 未配置的曲线保留调用方传入的两点插值结果，不配置任何曲线时与原有的昼夜过渡效果一致
+ * - 配置了材质参数集合时光源数值只写入集合，每帧一次全局参数更新；未配置时才逐个修改光源
+ * - 天空大气组件无法读取材质参数，大气颜色仍写入组件，同时也写入集合供材质使用
+ * - 服务器的昼夜管理器和客户端的玩家控制器共用同一份配置（由GameState复制）
+ */
+USTRUCT(BlueprintType)
+struct SEVENDAYSTOALIVE_API FSDTADayNightLightingProfile
+{
+	GENERATED_BODY()
+
+	/** 光源亮度曲线（横轴为昼夜循环进度） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	TObjectPtr<UCurveFloat> LightIntensityCurve = nullptr;
+
+	/** 光源颜色曲线（横轴为昼夜循环进度） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	TObjectPtr<UCurveLinearColor> LightColorCurve = nullptr;
+
+	/** 大气瑞利散射颜色曲线（横轴为昼夜循环进度） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	TObjectPtr<UCurveLinearColor> AtmosphereColorCurve = nullptr;
+
+	/** 接收光照数值的材质参数集合，为空时逐个修改带标签的光源 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	TObjectPtr<UMaterialParameterCollection> ParameterCollection = nullptr;
+
+	/** 光源亮度参数名（标量） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	FName LightIntensityParameter = FName("DayNightLightIntensity");
+
+	/** 光源颜色参数名（向量） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	FName LightColorParameter = FName("DayNightLightColor");
+
+	/** 大气颜色参数名（向量） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	FName AtmosphereColorParameter = FName("DayNightAtmosphereColor");
+
+	/** 昼夜循环进度参数名（标量） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day Night Lighting")
+	FName CycleProgressParameter = FName("DayNightCycleProgress");
+
+	/** 是否配置了任意曲线（配置后光照随整个循环连续变化，需要每帧求值） */
+	bool HasCurves() const;
+
+	/** 是否输出到材质参数集合 */
+	bool UsesParameterCollection() const { return ParameterCollection != nullptr; }
+
+	/**
+	 * 按昼夜循环进度求值
+	 *
+	 * @param CycleProgress 昼夜循环进度（0-1）
+	 * @param Fallback 未配置曲线的通道使用的数值
+	 * @return 光照数值
+	 */
+	FSDTADayNightLightingState Evaluate(float CycleProgress, const FSDTADayNightLightingState& Fallback) const;
+
+	/**
+	 * 把光照数值写入材质参数集合
+	 *
+	 * @param World 世界
+	 * @param State 光照数值
+	 * @param CycleProgress 昼夜循环进度（0-1）
+	 * @return 写入成功时返回true，未配置集合时返回false
+	 */
+	bool WriteParameters(UWorld* World, const FSDTADayNightLightingState& State, float CycleProgress) const;
+};
@@ -2,7 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Variant_SDTA/Core/Game/DayNight/SDTADayNightManager.h"
-#include "Kismet/GameplayStatics.h"
+#include "Variant_SDTA/Core/Game/DayNight/SDTAEnvironmentRegistry.h"
 #include "Components/LightComponent.h"
 #include "Components/SkyAtmosphereComponent.h"
 #include "Math/UnrealMathUtility.h"
@@ -44,10 +44,10 @@ void USDTADayNightManager::Initialize(UWorld* InWorld)
     World = InWorld;
     if (World)
     {
-        // 初始设置为白天
+        // 初始设置为白天（配置了曲线或材质参数集合时同样经过光照配置求值）
         bIsNight = false;
-        SetLightIntensityBasedOnTime(false);
-        SetAtmosphereColorBasedOnTime(false);
+        bHasAppliedLighting = false;
+        ApplyTransitionEffects(1.0f, false);
         
         // 开始昼夜循环
         StartDayNightCycle();
@@ -98,6 +98,11 @@ void USDTADayNightManager::Tick(float DeltaTime)
             OnTransitionCompleted.Broadcast();
         }
     }
+    else if (LightingProfile.HasCurves())
+    {
+        // 曲线驱动时光照随整个循环连续变化，每帧求值一次
+        ApplyTransitionEffects(1.0f, bIsNight);
+    }
     
     // 计算剩余时间和时间百分比
     float RemainingTime = GetRemainingTimeInternal();
@@ -191,33 +196,16 @@ TArray<class ULightComponent*> USDTADayNightManager::GetWorldLights(const FName&
 {
     TArray<class ULightComponent*> Lights;
     
-    if (!World) return Lights;
-    
-    // 获取所有带标签的光源
-    TArray<AActor*> Actors;
-    if (OptionalTag != NAME_None)
-    {
-        UGameplayStatics::GetAllActorsWithTag(World, OptionalTag, Actors);
-    }
-    else
-    {
-        UGameplayStatics::GetAllActorsWithTag(World, LightTag, Actors);
-    }
+    USDTAEnvironmentRegistry* Registry = USDTAEnvironmentRegistry::Get(World);
+    if (!Registry) return Lights;
     
-    // 遍历所有演员，获取光源组件
-    for (AActor* Actor : Actors)
+    // 从注册表缓存中获取光源，不再扫描整个世界
+    const FName Tag = OptionalTag != NAME_None ? OptionalTag : LightTag;
+    for (const TWeakObjectPtr<ULightComponent>& Light : Registry->GetLights(Tag))
     {
-        if (!Actor) continue;
-        
-        TArray<ULightComponent*> LightComponents;
-        Actor->GetComponents<ULightComponent>(LightComponents);
-        
-        for (ULightComponent* LightComp : LightComponents)
+        if (ULightComponent* LightComp = Light.Get())
         {
-            if (LightComp)
-            {
-                Lights.Add(LightComp);
-            }
+            Lights.Add(LightComp);
         }
     }
     
@@ -228,50 +216,27 @@ void USDTADayNightManager::SetLightIntensityBasedOnTime(bool bNight)
 {
     if (!World) return;
     
-    // 获取所有光源
-    TArray<ULightComponent*> Lights = GetWorldLights();
-    
     // 设置光源属性
     float TargetIntensity = bNight ? NightLightIntensity : DayLightIntensity;
     FLinearColor TargetColor = bNight ? NightLightColor : DayLightColor;
     
-    for (ULightComponent* Light : Lights)
-    {
-        if (Light)
-        {
-            Light->SetIntensity(TargetIntensity);
-            Light->SetLightColor(TargetColor);
-        }
-    }
+    ApplyLightSettings(TargetIntensity, TargetColor);
+    
+    // 直接修改了光源，下次求值时强制重新应用
+    bHasAppliedLighting = false;
 }
 
 void USDTADayNightManager::SetAtmosphereColorBasedOnTime(bool bNight)
 {
     if (!World) return;
     
-    // 获取所有带大气标签的演员
-    TArray<AActor*> AtmosphereActors;
-    UGameplayStatics::GetAllActorsWithTag(World, AtmosphereTag, AtmosphereActors);
-    
     // 设置大气属性
     FLinearColor TargetColor = bNight ? NightAtmosphereColor : DayAtmosphereColor;
     
-    for (AActor* Actor : AtmosphereActors)
-    {
-        if (!Actor) continue;
-        
-        // 获取天空大气组件
-        TArray<UActorComponent*> Components;
-        Actor->GetComponents(USkyAtmosphereComponent::StaticClass(), Components);
-        
-        for (UActorComponent* Component : Components)
-        {
-            if (USkyAtmosphereComponent* AtmosphereComp = Cast<USkyAtmosphereComponent>(Component))
-            {
-                AtmosphereComp->RayleighScattering = TargetColor;
-            }
-        }
-    }
+    ApplyAtmosphereColor(TargetColor);
+    
+    // 直接修改了大气，下次求值时强制重新应用
+    bHasAppliedLighting = false;
 }
 
 float USDTADayNightManager::GetRemainingTimeInternal() const
@@ -325,39 +290,69 @@ void USDTADayNightManager::ApplyTransitionEffects(float Progress, bool bToNight)
     FLinearColor StartAtmosphereColor = bToNight ? DayAtmosphereColor : NightAtmosphereColor;
     FLinearColor EndAtmosphereColor = bToNight ? NightAtmosphereColor : DayAtmosphereColor;
     
-    // 线性插值计算当前值
-    float CurrentIntensity = FMath::Lerp(StartIntensity, EndIntensity, Progress);
-    FLinearColor CurrentLightColor = FLinearColor::LerpUsingHSV(StartColor, EndColor, Progress);
-    FLinearColor CurrentAtmosphereColor = FLinearColor::LerpUsingHSV(StartAtmosphereColor, EndAtmosphereColor, Progress);
+    // 线性插值计算当前值（未配置曲线的通道使用）
+    FSDTADayNightLightingState Base;
+    Base.LightIntensity = FMath::Lerp(StartIntensity, EndIntensity, Progress);
+    Base.LightColor = FLinearColor::LerpUsingHSV(StartColor, EndColor, Progress);
+    Base.AtmosphereColor = FLinearColor::LerpUsingHSV(StartAtmosphereColor, EndAtmosphereColor, Progress);
     
-    // 更新光源
-    TArray<ULightComponent*> Lights = GetWorldLights();
-    for (ULightComponent* Light : Lights)
+    // 按曲线求值一次并应用
+    ApplyLighting(LightingProfile.Evaluate(GetCycleProgress(), Base));
+}
+
+float USDTADayNightManager::GetCycleProgress() const
+{
+    const float TotalCycleDuration = DayDuration + NightDuration;
+    return TotalCycleDuration > 0.0f ? FMath::Fmod(GameTime, TotalCycleDuration) / TotalCycleDuration : 0.0f;
+}
+
+void USDTADayNightManager::ApplyLighting(const FSDTADayNightLightingState& State)
+{
+    // 配置了材质参数集合时只写一次全局参数，光源材质从集合读取
+    const bool bWroteParameters = LightingProfile.WriteParameters(World, State, GetCycleProgress());
+    
+    if (!bWroteParameters && (!bHasAppliedLighting
+        || !FMath::IsNearlyEqual(State.LightIntensity, LastAppliedLighting.LightIntensity)
+        || !State.LightColor.Equals(LastAppliedLighting.LightColor)))
+    {
+        ApplyLightSettings(State.LightIntensity, State.LightColor);
+    }
+    
+    // 天空大气组件不读取材质参数，颜色变化时仍需写入组件
+    if (!bHasAppliedLighting || !State.AtmosphereColor.Equals(LastAppliedLighting.AtmosphereColor))
     {
-        if (Light)
+        ApplyAtmosphereColor(State.AtmosphereColor);
+    }
+    
+    LastAppliedLighting = State;
+    bHasAppliedLighting = true;
+}
+
+void USDTADayNightManager::ApplyLightSettings(float Intensity, const FLinearColor& Color)
+{
+    USDTAEnvironmentRegistry* Registry = USDTAEnvironmentRegistry::Get(World);
+    if (!Registry) return;
+    
+    for (const TWeakObjectPtr<ULightComponent>& Light : Registry->GetLights(LightTag))
+    {
+        if (ULightComponent* LightComp = Light.Get())
         {
-            Light->SetIntensity(CurrentIntensity);
-            Light->SetLightColor(CurrentLightColor);
+            LightComp->SetIntensity(Intensity);
+            LightComp->SetLightColor(Color);
         }
     }
+}
+
+void USDTADayNightManager::ApplyAtmosphereColor(const FLinearColor& Color)
+{
+    USDTAEnvironmentRegistry* Registry = USDTAEnvironmentRegistry::Get(World);
+    if (!Registry) return;
     
-    // 更新大气
-    TArray<AActor*> AtmosphereActors;
-    UGameplayStatics::GetAllActorsWithTag(World, AtmosphereTag, AtmosphereActors);
-    
-    for (AActor* Actor : AtmosphereActors)
+    for (const TWeakObjectPtr<USkyAtmosphereComponent>& Atmosphere : Registry->GetAtmospheres(AtmosphereTag))
     {
-        if (!Actor) continue;
-        
-        TArray<UActorComponent*> Components;
-        Actor->GetComponents(USkyAtmosphereComponent::StaticClass(), Components);
-        
-        for (UActorComponent* Component : Components)
+        if (USkyAtmosphereComponent* AtmosphereComp = Atmosphere.Get())
         {
-            if (USkyAtmosphereComponent* AtmosphereComp = Cast<USkyAtmosphereComponent>(Component))
-            {
-                AtmosphereComp->RayleighScattering = CurrentAtmosphereColor;
-            }
+            AtmosphereComp->RayleighScattering = Color;
         }
     }
 }
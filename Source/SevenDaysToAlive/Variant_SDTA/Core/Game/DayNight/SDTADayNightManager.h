@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Variant_SDTA/Core/Game/DayNight/SDTADayNightLighting.h"
 #include "SDTADayNightManager.generated.h"
 
 /**
@@ -13,7 +14,7 @@
  * 1. 管理昼夜循环系统
  * 2. 处理昼夜过渡效果
  * 3. 提供事件系统触发状态变化
- * 4. 管理光源和大气颜色
+ * 4. 管理光源和大气颜色，可由曲线驱动并输出到材质参数集合
  * 
  * 使用说明：
  * - 作为独立模块管理昼夜系统
@@ -67,9 +68,9 @@ public:
 	/**
 	 * 更新昼夜系统
 	 * 
-	 * 功能：在每帧调用，更新时间和处理过渡效果
+	 * 功能：由GameMode的固定步长时钟在每个模拟步调用，更新时间和处理过渡效果
 	 * 
-	 * @param DeltaTime 帧间隔时间（秒）
+	 * @param DeltaTime 模拟步长（秒，已包含时间缩放）
 	 */
 	void Tick(float DeltaTime);
 	
@@ -154,7 +155,7 @@ public:
 	/**
 	 * 获取世界中的光源列表
 	 * 
-	 * 功能：遍历世界中的所有光源，可选择按标签筛选
+	 * 功能：从环境注册表的缓存中获取光源，可选择按标签筛选
 	 * 
 	 * @param OptionalTag 可选的光源标签筛选
 	 * @return 返回符合条件的光源列表
@@ -240,6 +241,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Light Management")
 	FName AtmosphereTag; // 大气标签
 	
+	// 曲线驱动的光照配置（未配置曲线时使用上面的两点插值）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Light Management")
+	FSDTADayNightLightingProfile LightingProfile;
+	
 	// 事件系统
 	UPROPERTY(BlueprintAssignable, Category = "Day Night System")
 	FOnDayNightStateChanged OnDayNightStateChanged; // 昼夜状态变化事件
@@ -261,6 +266,10 @@ private:
 	float TransitionProgress; // 过渡进度（0-1）
 	bool bTransitionToNight; // 是否过渡到夜晚
 	
+	// 上次应用的光照，用于跳过未变化的光源和大气更新
+	FSDTADayNightLightingState LastAppliedLighting;
+	bool bHasAppliedLighting = false;
+	
 	// 计算剩余时间
 	float GetRemainingTimeInternal() const;
 	
@@ -270,6 +279,18 @@ private:
 	// 应用过渡效果
 	void ApplyTransitionEffects(float Progress, bool bToNight);
 	
+	// 计算昼夜循环进度（0-1，0为白天开始）
+	float GetCycleProgress() const;
+	
+	// 应用一次求值后的光照：配置了材质参数集合时写入集合，否则逐个修改光源；数值未变化的通道跳过
+	void ApplyLighting(const FSDTADayNightLightingState& State);
+	
+	// 设置所有缓存光源的亮度和颜色
+	void ApplyLightSettings(float Intensity, const FLinearColor& Color);
+	
+	// 设置所有缓存大气组件的瑞利散射颜色
+	void ApplyAtmosphereColor(const FLinearColor& Color);
+	
 	// 检查昼夜切换
 	void CheckDayNightTransition();
 	
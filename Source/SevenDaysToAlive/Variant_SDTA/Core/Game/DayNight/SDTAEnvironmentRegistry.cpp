@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAEnvironmentRegistry.cpp - 昼夜环境注册表实现文件
+ *
+ * 实现细节：
+ * - 每个标签只在第一次查询时遍历一次世界中的Actor，之后只处理新生成的Actor和新加载的关卡
+ * - 查询时原地压缩数组清理失效的弱指针，不需要监听Actor销毁和关卡卸载
+ */
+
+#include "Variant_SDTA/Core/Game/DayNight/SDTAEnvironmentRegistry.h"
+#include "SevenDaysToAlive.h"
+#include "Components/LightComponent.h"
+#include "Components/SkyAtmosphereComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+namespace
+{
+	/** 原地清理失效的弱指针 */
+	template <typename ComponentType>
+	void RemoveStale(TArray<TWeakObjectPtr<ComponentType>>& Components)
+	{
+		Components.RemoveAllSwap([](const TWeakObjectPtr<ComponentType>& Component) { return !Component.IsValid(); }, EAllowShrinking::No);
+	}
+}
+
+USDTAEnvironmentRegistry* USDTAEnvironmentRegistry::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USDTAEnvironmentRegistry>() : nullptr;
+}
+
+void USDTAEnvironmentRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USDTAEnvironmentRegistry::HandleActorSpawned));
+	}
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USDTAEnvironmentRegistry::HandleLevelAdded);
+}
+
+void USDTAEnvironmentRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	LevelAddedHandle.Reset();
+
+	TaggedComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+bool USDTAEnvironmentRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * 获取带指定标签的Actor上的所有光源组件
+ *
+ * @param Tag 光源标签
+ * @return 缓存的光源组件列表（已清理失效条目）
+ */
+const TArray<TWeakObjectPtr<ULightComponent>>& USDTAEnvironmentRegistry::GetLights(FName Tag)
+{
+	FTaggedComponents& Entry = FindOrBuild(Tag);
+	RemoveStale(Entry.Lights);
+	return Entry.Lights;
+}
+
+/**
+ * 获取带指定标签的Actor上的所有天空大气组件
+ *
+ * @param Tag 大气标签
+ * @return 缓存的天空大气组件列表（已清理失效条目）
+ */
+const TArray<TWeakObjectPtr<USkyAtmosphereComponent>>& USDTAEnvironmentRegistry::GetAtmospheres(FName Tag)
+{
+	FTaggedComponents& Entry = FindOrBuild(Tag);
+	RemoveStale(Entry.Atmospheres);
+	return Entry.Atmospheres;
+}
+
+/**
+ * 按Actor当前的标签和组件重新登记
+ *
+ * 功能：先从所有已追踪标签中移除该Actor的组件，再按当前标签重新加入
+ *
+ * @param Actor 需要登记的Actor
+ */
+void USDTAEnvironmentRegistry::RegisterActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	UnregisterActor(Actor);
+	AddActor(Actor);
+}
+
+/**
+ * 从所有缓存中移除Actor的组件
+ *
+ * @param Actor 需要移除的Actor
+ */
+void USDTAEnvironmentRegistry::UnregisterActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	for (TPair<FName, FTaggedComponents>& Pair : TaggedComponents)
+	{
+		RemoveActorComponents(Actor, Pair.Value);
+	}
+}
+
+/**
+ * 获取标签的缓存
+ *
+ * 功能：标签第一次被查询时遍历一次世界中的Actor建立缓存，之后由生成和关卡加载事件增量维护
+ *
+ * @param Tag 标签
+ * @return 标签的缓存
+ */
+USDTAEnvironmentRegistry::FTaggedComponents& USDTAEnvironmentRegistry::FindOrBuild(FName Tag)
+{
+	if (FTaggedComponents* Existing = TaggedComponents.Find(Tag))
+	{
+		return *Existing;
+	}
+
+	FTaggedComponents& Entry = TaggedComponents.Add(Tag);
+
+	UWorld* World = GetWorld();
+	if (World && Tag != NAME_None)
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (It->ActorHasTag(Tag))
+			{
+				AddActorComponents(*It, Entry);
+			}
+		}
+
+		UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAEnvironmentRegistry] 建立标签 %s 的缓存：光源 %d 个，大气 %d 个"),
+			*Tag.ToString(), Entry.Lights.Num(), Entry.Atmospheres.Num());
+	}
+
+	return Entry;
+}
+
+/**
+ * 把Actor的组件加入所有已追踪且Actor带有的标签
+ *
+ * @param Actor Actor
+ */
+void USDTAEnvironmentRegistry::AddActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || Actor->Tags.Num() == 0)
+	{
+		return;
+	}
+
+	for (TPair<FName, FTaggedComponents>& Pair : TaggedComponents)
+	{
+		if (Actor->ActorHasTag(Pair.Key))
+		{
+			AddActorComponents(Actor, Pair.Value);
+		}
+	}
+}
+
+/**
+ * 把Actor的组件加入指定标签的缓存
+ *
+ * @param Actor Actor
+ * @param Entry 标签的缓存
+ */
+void USDTAEnvironmentRegistry::AddActorComponents(AActor* Actor, FTaggedComponents& Entry)
+{
+	TInlineComponentArray<ULightComponent*> Lights(Actor);
+	for (ULightComponent* Light : Lights)
+	{
+		Entry.Lights.AddUnique(Light);
+	}
+
+	TInlineComponentArray<USkyAtmosphereComponent*> Atmospheres(Actor);
+	for (USkyAtmosphereComponent* Atmosphere : Atmospheres)
+	{
+		Entry.Atmospheres.AddUnique(Atmosphere);
+	}
+}
+
+/**
+ * 从指定标签的缓存中移除Actor的组件
+ *
+ * @param Actor Actor
+ * @param Entry 标签的缓存
+ */
+void USDTAEnvironmentRegistry::RemoveActorComponents(const AActor* Actor, FTaggedComponents& Entry)
+{
+	Entry.Lights.RemoveAllSwap([Actor](const TWeakObjectPtr<ULightComponent>& Light)
+	{
+		return !Light.IsValid() || Light->GetOwner() == Actor;
+	}, EAllowShrinking::No);
+
+	Entry.Atmospheres.RemoveAllSwap([Actor](const TWeakObjectPtr<USkyAtmosphereComponent>& Atmosphere)
+	{
+		return !Atmosphere.IsValid() || Atmosphere->GetOwner() == Actor;
+	}, EAllowShrinking::No);
+}
+
+void USDTAEnvironmentRegistry::HandleActorSpawned(AActor* Actor)
+{
+	AddActor(Actor);
+}
+
+void USDTAEnvironmentRegistry::HandleLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+	if (!Level || InWorld != GetWorld() || TaggedComponents.Num() == 0)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		AddActor(Actor);
+	}
+}
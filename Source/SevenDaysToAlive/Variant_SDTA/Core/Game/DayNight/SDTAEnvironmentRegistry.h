@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTAEnvironmentRegistry.generated.h"
+
+class ULightComponent;
+class USkyAtmosphereComponent;
+
+/**
+ * 昼夜环境注册表
+ *
+ * 核心功能：
+ * 1. 按标签缓存带光源标签（LightTag）的Actor上的光源组件和带大气标签（AtmosphereTag）的Actor上的天空大气组件
+ * 2. 昼夜管理器（服务器）和玩家控制器（客户端）过渡时直接遍历缓存的组件列表，不再每帧扫描整个世界
+ *
+ * 设计要点：
+ * - 某个标签第一次被查询时扫描一次世界建立缓存，之后通过Actor生成和关卡流送加载事件增量追踪
+ * - 组件以弱指针保存，Actor被销毁或关卡被卸载后对应条目在下次查询时清理
+ * - 运行时修改Actor标签或增删光源组件后，调用RegisterActor/UnregisterActor同步缓存
+ * - 作为世界子系统随世界创建和销毁，通过USDTAEnvironmentRegistry::Get直接获取
+ */
+UCLASS()
+class SEVENDAYSTOALIVE_API USDTAEnvironmentRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 获取世界中的环境注册表
+	 * @param WorldContextObject 世界上下文对象
+	 * @return 环境注册表，不支持的世界返回nullptr
+	 */
+	static USDTAEnvironmentRegistry* Get(const UObject* WorldContextObject);
+
+	// USubsystem接口
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * 获取带指定标签的Actor上的所有光源组件
+	 *
+	 * @param Tag 光源标签
+	 * @return 缓存的光源组件列表（已清理失效条目）
+	 */
+	const TArray<TWeakObjectPtr<ULightComponent>>& GetLights(FName Tag);
+
+	/**
+	 * 获取带指定标签的Actor上的所有天空大气组件
+	 *
+	 * @param Tag 大气标签
+	 * @return 缓存的天空大气组件列表（已清理失效条目）
+	 */
+	const TArray<TWeakObjectPtr<USkyAtmosphereComponent>>& GetAtmospheres(FName Tag);
+
+	/**
+	 * 按Actor当前的标签和组件重新登记（运行时修改标签或组件后调用）
+	 *
+	 * @param Actor 需要登记的Actor
+	 */
+	void RegisterActor(AActor* Actor);
+
+	/**
+	 * 从所有缓存中移除Actor的组件
+	 *
+	 * @param Actor 需要移除的Actor
+	 */
+	void UnregisterActor(AActor* Actor);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** 单个标签的缓存 */
+	struct FTaggedComponents
+	{
+		TArray<TWeakObjectPtr<ULightComponent>> Lights; // 光源组件
+		TArray<TWeakObjectPtr<USkyAtmosphereComponent>> Atmospheres; // 天空大气组件
+	};
+
+	/** 获取标签的缓存，第一次查询时扫描世界建立 */
+	FTaggedComponents& FindOrBuild(FName Tag);
+
+	/** 把Actor的组件加入所有已追踪且Actor带有的标签 */
+	void AddActor(AActor* Actor);
+
+	/** 把Actor的组件加入指定标签的缓存 */
+	static void AddActorComponents(AActor* Actor, FTaggedComponents& Entry);
+
+	/** 从指定标签的缓存中移除Actor的组件 */
+	static void RemoveActorComponents(const AActor* Actor, FTaggedComponents& Entry);
+
+	/** Actor生成回调 */
+	void HandleActorSpawned(AActor* Actor);
+
+	/** 流送关卡加载回调 */
+	void HandleLevelAdded(ULevel* Level, UWorld* InWorld);
+
+	/** 已追踪的标签 */
+	TMap<FName, FTaggedComponents> TaggedComponents;
+
+	/** 事件句柄 */
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAFixedStepClock.cpp - 固定步长模拟时钟实现文件
+ *
+ * 实现细节：
+ * - 累加时间用double保存，长时间运行后步数和模拟时间仍然精确
+ * - 超出追赶上限时只保留不足一步的余数，丢弃的时间不会在之后的帧中补回
+ */
+
+#include "Variant_SDTA/Core/Game/SDTAFixedStepClock.h"
+#include "HAL/IConsoleManager.h"
+
+namespace SDTAFixedStepClock
+{
+	static float GTimeScale = 1.0f;
+	static FAutoConsoleVariableRef CVarTimeScale(
+		TEXT("sdta.Sim.TimeScale"),
+		GTimeScale,
+		TEXT("游戏规则层（昼夜、波次）的模拟时间缩放（默认1，0表示暂停，大于1用于加速运行）"));
+}
+
+/**
+ * 设置步长和每帧最大追赶步数
+ *
+ * @param InStepRate 每秒模拟步数
+ * @param InMaxSubsteps 每帧最多执行的模拟步数
+ */
+void FSDTAFixedStepClock::Configure(float InStepRate, int32 InMaxSubsteps)
+{
+	StepSeconds = 1.0 / FMath::Max(InStepRate, 1.0f);
+	MaxSubsteps = FMath::Max(InMaxSubsteps, 1);
+}
+
+/**
+ * 累加帧时间并计算本帧需要执行的模拟步数
+ *
+ * @param DeltaTime 帧间隔时间（秒，未缩放）
+ * @return 本帧需要执行的模拟步数
+ */
+int32 FSDTAFixedStepClock::Advance(float DeltaTime)
+{
+	Accumulator += FMath::Max(DeltaTime, 0.0f) * static_cast<double>(GetTimeScale());
+
+	int32 Steps = FMath::FloorToInt32(Accumulator / StepSeconds);
+	LastDroppedSteps = 0;
+
+	// 卡顿帧只追赶MaxSubsteps步，其余时间丢弃
+	if (Steps > MaxSubsteps)
+	{
+		LastDroppedSteps = Steps - MaxSubsteps;
+		Steps = MaxSubsteps;
+		Accumulator = FMath::Fmod(Accumulator, StepSeconds);
+	}
+	else
+	{
+		Accumulator -= Steps * StepSeconds;
+	}
+
+	StepCount += Steps;
+	SimulationTime += Steps * StepSeconds;
+	return Steps;
+}
+
+/**
+ * 清空累加时间和统计
+ */
+void FSDTAFixedStepClock::Reset()
+{
+	Accumulator = 0.0;
+	SimulationTime = 0.0;
+	StepCount = 0;
+	LastDroppedSteps = 0;
+}
+
+float FSDTAFixedStepClock::GetTimeScale() const
+{
+	return TimeScale * FMath::Max(SDTAFixedStepClock::GTimeScale, 0.0f);
+}
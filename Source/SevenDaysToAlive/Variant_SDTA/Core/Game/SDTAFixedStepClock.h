@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 固定步长模拟时钟
+ *
+ * 核心功能：
+ * 1. 把每帧可变的DeltaTime累加起来，按固定步长拆分为若干模拟步，游戏规则层（昼夜、波次）每步推进相同的时间
+ * 2. 卡顿帧按步追赶，每帧最多追赶MaxSubsteps步，超出部分丢弃，避免卡顿后越追越慢
+ * 3. 支持时间缩放：实例缩放 × 控制台变量 sdta.Sim.TimeScale，用于无头服务器加速运行和调试
+ *
+ * 设计要点：
+ * - 阶段边界和生成时机只取决于模拟步数，不受帧率影响；给定相同的步长和输入，服务器模拟结果可复现
+ * - 丢弃的步数会累计，调用方可据此重新对齐需要与世界时间对应的数据（如复制给客户端的阶段时间锚点）
+ * - 只保存数值，不持有UObject，由ASDTAGameMode持有并在Tick中推进
+ *
+ * 控制台变量：
+ * - sdta.Sim.TimeScale N：全局模拟时间缩放（默认1，0表示暂停游戏规则层）
+ */
+class SEVENDAYSTOALIVE_API FSDTAFixedStepClock
+{
+public:
+	/**
+	 * 设置步长和每帧最大追赶步数
+	 *
+	 * @param InStepRate 每秒模拟步数
+	 * @param InMaxSubsteps 每帧最多执行的模拟步数
+	 */
+	void Configure(float InStepRate, int32 InMaxSubsteps);
+
+	/**
+	 * 累加帧时间并计算本帧需要执行的模拟步数
+	 *
+	 * @param DeltaTime 帧间隔时间（秒，未缩放）
+	 * @return 本帧需要执行的模拟步数，每步推进GetStepSeconds()秒
+	 */
+	int32 Advance(float DeltaTime);
+
+	/** 清空累加时间和统计 */
+	void Reset();
+
+	/** 每步推进的模拟时间（秒） */
+	float GetStepSeconds() const { return static_cast<float>(StepSeconds); }
+
+	/** 生效的时间缩放（实例缩放 × sdta.Sim.TimeScale） */
+	float GetTimeScale() const;
+
+	/** 设置实例时间缩放 */
+	void SetTimeScale(float InTimeScale) { TimeScale = FMath::Max(InTimeScale, 0.0f); }
+
+	/** 累计的模拟时间（秒） */
+	double GetSimulationTime() const { return SimulationTime; }
+
+	/** 累计执行的模拟步数 */
+	int64 GetStepCount() const { return StepCount; }
+
+	/** 上一次Advance因超出追赶上限而丢弃的步数 */
+	int32 GetLastDroppedSteps() const { return LastDroppedSteps; }
+
+	/** 未满一步的累加时间占步长的比例（0-1），可用于表现层插值 */
+	float GetInterpolationAlpha() const { return static_cast<float>(Accumulator / StepSeconds); }
+
+private:
+	/** 步长（秒） */
+	double StepSeconds = 1.0 / 30.0;
+
+	/** 每帧最多执行的模拟步数 */
+	int32 MaxSubsteps = 8;
+
+	/** 实例时间缩放 */
+	float TimeScale = 1.0f;
+
+	/** 未满一步的累加时间（秒，已缩放） */
+	double Accumulator = 0.0;
+
+	/** 累计的模拟时间（秒） */
+	double SimulationTime = 0.0;
+
+	/** 累计执行的模拟步数 */
+	int64 StepCount = 0;
+
+	/** 上一次Advance丢弃的步数 */
+	int32 LastDroppedSteps = 0;
+};
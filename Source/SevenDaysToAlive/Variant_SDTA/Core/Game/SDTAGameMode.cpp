@@ -18,12 +18,13 @@
  * 
  * 使用说明：
  * - 作为游戏的核心控制器，协调各个系统的工作
- * - 通过GetPoolManager()方法提供对象池访问接口
+ * - 通过GetPoolManager()方法提供对象池访问接口（对象池本身是世界子系统，也可通过USDTAPoolManager::Get获取）
  * - 管理游戏内的时间流逝和昼夜变化
  */
 
 #include "Variant_SDTA/Core/Game/SDTAGameMode.h"
 #include "Variant_SDTA/Weapons/SDTAWeaponManager.h"
+#include "Variant_SDTA/Weapons/SDTABullet.h"
 #include "SevenDaysToAlive.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/World.h"
@@ -43,10 +44,21 @@
 
 // 包含昼夜管理器头文件
 #include "Variant_SDTA/Core/Game/DayNight/SDTADayNightManager.h"
+#include "Variant_SDTA/Core/Game/Spawn/SDTASpawnPlanner.h"
+#include "Variant_SDTA/Core/Game/Spawn/SDTAWaveDirector.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyManager.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
 
 /** 定义自定义日志类别：关键游戏事件 */
 DEFINE_LOG_CATEGORY(LogKeyGameEvent);
 
+/** 波次生成调度性能统计（stat SDTASpawn） */
+DECLARE_STATS_GROUP(TEXT("SDTA Spawn"), STATGROUP_SDTASpawn, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Process Spawn Queue"), STAT_SDTASpawn_ProcessQueue, STATGROUP_SDTASpawn);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Queue Depth"), STAT_SDTASpawn_QueueDepth, STATGROUP_SDTASpawn);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawned This Frame"), STAT_SDTASpawn_SpawnedThisFrame, STATGROUP_SDTASpawn);
+
 #pragma region 构造函数和基础方法
 ASDTAGameMode::ASDTAGameMode()
 {
@@ -67,9 +79,29 @@ ASDTAGameMode::ASDTAGameMode()
 	CurrentEnemyCount = 0;
 	MaxEnemyCount = 20;
 	
-	// 设置默认敌人生成配置（7天的标准配置）
-	WaveSizes = { 3, 5, 8, 12, 15, 18, 20 }; // 每天生成敌人数量
-	WaveIntervals = { 60.0f, 45.0f, 30.0f, 25.0f, 20.0f, 15.0f, 10.0f }; // 每天生成间隔（秒）
+	// 波次节奏由数据表配置，未设置时波次导演使用默认节奏
+	WaveDataTable = nullptr;
+	WaveDirector = nullptr;
+	
+	// 生成点规划默认配置
+	SpawnMinDistance = 500.0f;
+	SpawnMaxDistance = 1500.0f;
+	SpawnRegionSize = 1000.0f;
+	SpawnCandidatesPerRegion = 8;
+	SpawnMinSeparation = 120.0f;
+	SpawnMaxProjectionHeight = 200.0f;
+	bSpawnAvoidPlayerSight = true;
+	SpawnPlanner = nullptr;
+	
+	// 分帧生成默认预算
+	MaxSpawnsPerFrame = 4;
+	SpawnBudgetMs = 2.0f;
+	NextPendingSpawn = 0;
+	
+	// 敌人AI默认配置
+	EnemyRepathDistance = 150.0f;
+	EnemyMaxPathRequestsPerFrame = 8;
+	bEnemyUseFlowField = true;
 	
 	SoulFragments = 0;
 	
@@ -85,6 +117,11 @@ ASDTAGameMode::ASDTAGameMode()
 	NightDuration = 300.0f; // 夜晚 5 分钟
 	TransitionDuration = 5.0f; // 5 秒过渡
 	
+	// 固定步长模拟默认配置
+	SimulationStepRate = 30.0f; // 每秒 30 步
+	MaxSimulationSubsteps = 8; // 卡顿时每帧最多追赶 8 步
+	SimulationTimeScale = 1.0f;
+	
 	// 光源默认配置
 	DayLightIntensity = 3.0f;
 	NightLightIntensity = 0.5f;
@@ -97,6 +134,10 @@ ASDTAGameMode::ASDTAGameMode()
 	NightAtmosphereColor = FLinearColor(0.1f, 0.1f, 0.3f); // 夜晚深蓝色
 	AtmosphereTag = FName("WorldAtmosphere");
 	
+	// 对象池默认配置
+	BulletPoolPrewarmSize = 32;
+	PoolPrewarmBudgetMs = 2.0f;
+	
 	// 日志输出控制
 	LastLogTime = 0.0f;
 }
@@ -112,11 +153,60 @@ void ASDTAGameMode::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	// 初始化对象池管理器
-	PoolManager = NewObject<USDTAPoolManager>(this, USDTAPoolManager::StaticClass());
+	// 初始化波次导演（需在预热敌人对象池之前，预热数量由波次数据决定）
+	if (HasAuthority())
+	{
+		WaveDirector = NewObject<USDTAWaveDirector>(this);
+		WaveDirector->Initialize(WaveDataTable, EnemyClass, MaxEnemyCount);
+	}
+	
+	// 获取对象池子系统（随世界创建，这里只推送配置并开始预热）
+	PoolManager = USDTAPoolManager::Get(this);
 	if (PoolManager)
 	{
-		PoolManager->Initialize(GetWorld());
+		PoolManager->PrewarmBudgetMs = PoolPrewarmBudgetMs;
+		PoolManager->OnPoolPrewarmCompleted.AddDynamic(this, &ASDTAGameMode::OnPoolPrewarmCompleted);
+
+		// 在第一天白天预热第一夜的敌人对象池，夜晚开始时不再构造敌人Actor
+		PrewarmEnemyPool(CurrentDay);
+
+		// 预热子弹对象池，开火时不再构造子弹Actor
+		PrewarmBulletPools();
+	}
+	
+	// 初始化敌人生成点规划器（只在服务器端生成敌人）
+	if (HasAuthority())
+	{
+		SpawnPlanner = NewObject<USDTASpawnPlanner>(this);
+		SpawnPlanner->MinSpawnDistance = SpawnMinDistance;
+		SpawnPlanner->MaxSpawnDistance = SpawnMaxDistance;
+		SpawnPlanner->RegionSize = SpawnRegionSize;
+		SpawnPlanner->CandidatesPerRegion = SpawnCandidatesPerRegion;
+		SpawnPlanner->MinSeparation = SpawnMinSeparation;
+		SpawnPlanner->MaxProjectionHeight = SpawnMaxProjectionHeight;
+		SpawnPlanner->bAvoidPlayerSight = bSpawnAvoidPlayerSight;
+
+		// 生成点抬高到敌人胶囊体中心，避免生成时与地面穿插
+		const ACharacter* EnemyCDO = EnemyClass ? EnemyClass->GetDefaultObject<ACharacter>() : nullptr;
+		if (EnemyCDO && EnemyCDO->GetCapsuleComponent())
+		{
+			SpawnPlanner->SpawnHeightOffset = EnemyCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		}
+
+		SpawnPlanner->Initialize(GetWorld());
+	}
+	
+	// 推送敌人AI更新配置（管理器是世界子系统，随世界创建）
+	if (USDTAEnemyManager* EnemyManager = USDTAEnemyManager::Get(this))
+	{
+		EnemyManager->RepathDistance = EnemyRepathDistance;
+		EnemyManager->MaxPathRequestsPerFrame = EnemyMaxPathRequestsPerFrame;
+		EnemyManager->bUseFlowField = bEnemyUseFlowField;
+		
+		if (EnemySignificanceTiers.Num() > 0)
+		{
+			EnemyManager->SignificanceTiers = EnemySignificanceTiers;
+		}
 	}
 	
 	// 初始化昼夜管理器
@@ -143,6 +233,7 @@ void ASDTAGameMode::BeginPlay()
 		DayNightManager->DayAtmosphereColor = DayAtmosphereColor;
 		DayNightManager->NightAtmosphereColor = NightAtmosphereColor;
 		DayNightManager->AtmosphereTag = AtmosphereTag;
+		DayNightManager->LightingProfile = DayNightLighting;
 		
 		// 初始化昼夜管理器
 		DayNightManager->Initialize(GetWorld());
@@ -157,7 +248,8 @@ void ASDTAGameMode::BeginPlay()
 	if (SDTAGameState)
 	{
 		SDTAGameState->CurrentDay = 1;
-		SDTAGameState->bIsNight = false;
+		SDTAGameState->SetPhaseDurations(DayDuration, NightDuration, TransitionDuration);
+		SDTAGameState->SetDayPhase(ESDTADayPhase::Day, 0.0f, SDTAGameState->GetServerWorldTimeSeconds(), SimulationClock.GetTimeScale());
 		SDTAGameState->CurrentEnemyCount = 0;
 		SDTAGameState->MaxEnemyCount = MaxEnemyCount;
 		SDTAGameState->GlobalSoulFragments = 0;
@@ -173,6 +265,7 @@ void ASDTAGameMode::BeginPlay()
 		SDTAGameState->NightLightColor = NightLightColor;
 		SDTAGameState->DayAtmosphereColor = DayAtmosphereColor;
 		SDTAGameState->NightAtmosphereColor = NightAtmosphereColor;
+		SDTAGameState->LightingProfile = DayNightLighting;
 
 		if (WeaponDataTable)
 		{
@@ -190,12 +283,31 @@ void ASDTAGameMode::Tick(float DeltaTime)
 	
 	if (bGameStarted && !bGameOver)
 	{
-		// 调用昼夜管理器的 Tick 方法
-		if (DayNightManager)
+		// 游戏规则层按固定步长推进，帧率和卡顿不影响阶段边界和生成时机
+		SimulationClock.Configure(SimulationStepRate, MaxSimulationSubsteps);
+		SimulationClock.SetTimeScale(SimulationTimeScale);
+		
+		const int32 Steps = SimulationClock.Advance(DeltaTime);
+		for (int32 Step = 0; Step < Steps; ++Step)
 		{
-			DayNightManager->Tick(DeltaTime);
+			StepSimulation(SimulationClock.GetStepSeconds());
+		}
+		
+		// 丢弃了追赶步数或时间缩放变化时，重新设置客户端用于本地计时的阶段时间锚点
+		ASDTAGameState* SDTAGameState = GetSDTAGameState();
+		if (SimulationClock.GetLastDroppedSteps() > 0
+			|| (SDTAGameState && !FMath::IsNearlyEqual(SDTAGameState->SimulationTimeScale, SimulationClock.GetTimeScale())))
+		{
+			if (SimulationClock.GetLastDroppedSteps() > 0)
+			{
+				UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTAGameMode] 模拟追赶超出上限，丢弃 %d 步"), SimulationClock.GetLastDroppedSteps());
+			}
+			SyncDayPhaseAnchor();
 		}
 		
+		// 按帧预算生成等待队列中的敌人
+		ProcessSpawnQueue();
+		
 		// 检查游戏结束条件
 		CheckWinCondition();
 		CheckLoseCondition();
@@ -205,6 +317,57 @@ void ASDTAGameMode::Tick(float DeltaTime)
 	}
 }
 
+/**
+ * 推进一个模拟步
+ * 
+ * 功能：以固定步长推进昼夜管理器和波次导演
+ * 
+ * @param StepSeconds 步长（秒，已包含时间缩放）
+ */
+void ASDTAGameMode::StepSimulation(float StepSeconds)
+{
+	// 调用昼夜管理器的 Tick 方法
+	if (DayNightManager)
+	{
+		DayNightManager->Tick(StepSeconds);
+	}
+	
+	// 波次导演按夜晚进度增量决定本步需要补充的敌人
+	if (WaveDirector && WaveDirector->IsNightActive())
+	{
+		const int32 EnemiesDue = WaveDirector->Advance(StepSeconds, CurrentEnemyCount + GetSpawnQueueDepth(), GetNumPlayers());
+		if (EnemiesDue > 0)
+		{
+			WaveDirector->NotifySpawned(SpawnEnemyWave(EnemiesDue));
+		}
+	}
+}
+
+/**
+ * 重新设置复制给客户端的阶段时间锚点
+ * 
+ * 功能：客户端按 锚点已用时间 + (服务器时间 - 锚点时间) × 时间缩放 计算阶段已用时间，
+ *       阶段切换、时间缩放变化或丢弃追赶步数后以昼夜管理器的实际进度和当前服务器时间作为新锚点
+ * 设计要点：锚点记录已用时间而不是回推阶段开始时间，时间缩放为0时客户端的进度停在锚点处
+ */
+void ASDTAGameMode::SyncDayPhaseAnchor()
+{
+	ASDTAGameState* SDTAGameState = GetSDTAGameState();
+	if (!SDTAGameState)
+	{
+		return;
+	}
+	
+	float PhaseElapsed = 0.0f;
+	if (DayNightManager)
+	{
+		const float PhaseDuration = bIsNight ? DayNightManager->NightDuration : DayNightManager->DayDuration;
+		PhaseElapsed = FMath::Max(0.0f, PhaseDuration - DayNightManager->GetRemainingTime());
+	}
+	SDTAGameState->SetDayPhase(bIsNight ? ESDTADayPhase::Night : ESDTADayPhase::Day, PhaseElapsed,
+		SDTAGameState->GetServerWorldTimeSeconds(), SimulationClock.GetTimeScale());
+}
+
 void ASDTAGameMode::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -232,121 +395,248 @@ void ASDTAGameMode::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLif
 
 
 #pragma region 敌人生成系统 - 方法声明
-void ASDTAGameMode::SpawnEnemyWave()
+/**
+ * 生成一批敌人
+ * 
+ * 功能：规划生成点，由波次导演为每个敌人选择类型，然后放入等待队列按帧预算生成
+ * 
+ * @param EnemiesToSpawn 请求生成的敌人数量
+ * @return 实际入队的敌人数量
+ */
+int32 ASDTAGameMode::SpawnEnemyWave(int32 EnemiesToSpawn)
 {
 	// 主机权威：只在服务器端执行
-	if (!HasAuthority()) return;
+	if (!HasAuthority()) return 0;
+
+	// 限制生成数量，不超过最大敌人数量（等待队列中的敌人也占用名额）
+	int32 AvailableSlots = MaxEnemyCount - CurrentEnemyCount - GetSpawnQueueDepth();
+	EnemiesToSpawn = FMath::Min(EnemiesToSpawn, AvailableSlots);
 
-	// 检查是否达到最大敌人数量
-	if (CurrentEnemyCount >= MaxEnemyCount)
+	if (EnemiesToSpawn <= 0)
 	{
-		UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 已达到最大敌人数量: %d / %d"), 
-		       CurrentEnemyCount, MaxEnemyCount);
-		return;
+		return 0;
 	}
 
-	// 获取当前天数的敌人生成数量
-	int32 WaveIndex = FMath::Min(CurrentDay - 1, WaveSizes.Num() - 1);
-	int32 EnemiesToSpawn = WaveSizes.IsValidIndex(WaveIndex) ? WaveSizes[WaveIndex] : 3;
+	UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTAGameMode] 第 %d 夜生成敌人，数量: %d"), 
+	       CurrentDay, EnemiesToSpawn);
 
-	// 限制生成数量，不超过最大敌人数量
-	int32 AvailableSlots = MaxEnemyCount - CurrentEnemyCount;
-	EnemiesToSpawn = FMath::Min(EnemiesToSpawn, AvailableSlots);
+	// 先规划整波敌人的生成位置（基于导航网格候选点，兼顾所有玩家），再放入等待队列按帧预算生成
+	TArray<FTransform> SpawnTransforms;
+	SpawnTransforms.Reserve(EnemiesToSpawn);
+	if (SpawnPlanner && SpawnPlanner->PlanWave(EnemiesToSpawn) > 0)
+	{
+		FTransform SpawnTransform;
+		while (SpawnPlanner->PopSpawnTransform(SpawnTransform))
+		{
+			SpawnTransforms.Add(SpawnTransform);
+		}
+	}
 
-	if (EnemiesToSpawn <= 0)
+	// 候选点不足（如导航网格尚未构建）时，剩余敌人在随机玩家周围的环形区域生成
+	if (SpawnTransforms.Num() < EnemiesToSpawn)
+	{
+		TArray<FVector> PlayerLocations;
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (PlayerController && PlayerController->GetPawn())
+			{
+				PlayerLocations.Add(PlayerController->GetPawn()->GetActorLocation());
+			}
+		}
+
+		if (PlayerLocations.Num() == 0)
+		{
+			return 0;
+		}
+
+		const int32 FallbackCount = EnemiesToSpawn - SpawnTransforms.Num();
+		for (int32 i = SpawnTransforms.Num(); i < EnemiesToSpawn; i++)
+		{
+			const FVector& PlayerLocation = PlayerLocations[FMath::RandRange(0, PlayerLocations.Num() - 1)];
+			const float SpawnDistance = FMath::FRandRange(SpawnMinDistance, SpawnMaxDistance);
+			const float Angle = FMath::FRandRange(0.0f, 2 * PI);
+
+			const FVector SpawnLocation = PlayerLocation + FVector(
+				FMath::Cos(Angle) * SpawnDistance,
+				FMath::Sin(Angle) * SpawnDistance,
+				0.0f
+			);
+
+			SpawnTransforms.Emplace(FRotator::ZeroRotator, SpawnLocation);
+		}
+
+		UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTAGameMode] 生成点候选不足，%d 个敌人使用随机环形位置"),
+		       FallbackCount);
+	}
+
+	// 按类型排序后入队，同类型的敌人在ProcessSpawnQueue中可以一次批量获取
+	TArray<TSubclassOf<AEnemyBase>> SpawnClasses;
+	SpawnClasses.Reserve(SpawnTransforms.Num());
+	for (int32 i = 0; i < SpawnTransforms.Num(); i++)
+	{
+		SpawnClasses.Add(WaveDirector ? WaveDirector->PickEnemyClass() : TSubclassOf<AEnemyBase>(EnemyClass));
+	}
+	SpawnClasses.Sort([](const TSubclassOf<AEnemyBase>& A, const TSubclassOf<AEnemyBase>& B) { return A.Get() < B.Get(); });
+
+	PendingSpawns.Reserve(PendingSpawns.Num() + SpawnTransforms.Num());
+	for (int32 i = 0; i < SpawnTransforms.Num(); i++)
+	{
+		PendingSpawns.Add({ SpawnTransforms[i], SpawnClasses[i] });
+	}
+
+	WaveSpawnStats.TotalQueued += SpawnTransforms.Num();
+	WaveSpawnStats.QueueDepth = GetSpawnQueueDepth();
+	WaveSpawnStats.PeakQueueDepth = FMath::Max(WaveSpawnStats.PeakQueueDepth, WaveSpawnStats.QueueDepth);
+
+	return SpawnTransforms.Num();
+}
+
+/**
+ * 按每帧预算生成等待队列中的敌人
+ * 
+ * 功能：每帧从等待队列取出一批生成变换，通过对象池批量生成敌人
+ * 设计要点：
+ * 1. 每帧生成数量不超过MaxSpawnsPerFrame
+ * 2. SpawnBudgetMs大于0时，按单个敌人的平均生成耗时估算本帧可生成的数量，至少生成1个保证队列前进
+ * 3. 整批通过AcquireEnemyBatch获取，保留批量获取只查找一次对象池的优势
+ * 4. 记录每帧耗时、峰值和超预算帧数，用于调整预算
+ */
+void ASDTAGameMode::ProcessSpawnQueue()
+{
+	const int32 QueueDepth = GetSpawnQueueDepth();
+	SET_DWORD_STAT(STAT_SDTASpawn_QueueDepth, QueueDepth);
+	SET_DWORD_STAT(STAT_SDTASpawn_SpawnedThisFrame, 0);
+
+	if (QueueDepth <= 0)
 	{
 		return;
 	}
 
-	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 生成第 %d 波敌人，数量: %d"), 
-	       CurrentDay, EnemiesToSpawn);
+	SCOPE_CYCLE_COUNTER(STAT_SDTASpawn_ProcessQueue);
 
-	// 逐个生成敌人
-	for (int32 i = 0; i < EnemiesToSpawn; i++)
+	// 计算本帧生成数量
+	int32 SpawnCount = FMath::Min(QueueDepth, FMath::Max(1, MaxSpawnsPerFrame));
+	if (SpawnBudgetMs > 0.0f && WaveSpawnStats.AverageSpawnCostMs > 0.0f)
 	{
-		// 获取玩家位置作为参考
-		APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
-		if (!PlayerController || !PlayerController->GetPawn())
+		const int32 AffordableCount = FMath::FloorToInt(SpawnBudgetMs / WaveSpawnStats.AverageSpawnCostMs);
+		SpawnCount = FMath::Clamp(AffordableCount, 1, SpawnCount);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 队列按类型排序入队，连续的同类型敌人一次批量获取
+	TArray<AEnemyBase*> NewEnemies;
+	TArray<AEnemyBase*> RunEnemies;
+	TArray<FTransform> RunTransforms;
+	const int32 FrameEnd = NextPendingSpawn + SpawnCount;
+	while (NextPendingSpawn < FrameEnd)
+	{
+		const TSubclassOf<AEnemyBase> RunClass = PendingSpawns[NextPendingSpawn].EnemyClass;
+		RunTransforms.Reset();
+		while (NextPendingSpawn < FrameEnd && PendingSpawns[NextPendingSpawn].EnemyClass == RunClass)
 		{
-			continue;
+			RunTransforms.Add(PendingSpawns[NextPendingSpawn++].Transform);
 		}
 
-		FVector PlayerLocation = PlayerController->GetPawn()->GetActorLocation();
+		AcquireEnemyBatch(RunClass, RunTransforms, RunEnemies);
+		NewEnemies.Append(RunEnemies);
+	}
+
+	// 队列全部取出后整体重置，避免数组无限增长
+	if (NextPendingSpawn >= PendingSpawns.Num())
+	{
+		PendingSpawns.Reset();
+		NextPendingSpawn = 0;
+	}
 
-		// 在玩家周围随机位置生成敌人（距离 500-1500 cm）
-		float SpawnDistance = FMath::FRandRange(500.0f, 1500.0f);
-		float Angle = FMath::FRandRange(0.0f, 2 * PI);
+	for (AEnemyBase* NewEnemy : NewEnemies)
+	{
+		RegisterSpawnedEnemy(NewEnemy);
+	}
 
-		FVector SpawnLocation = PlayerLocation + FVector(
-			FMath::Cos(Angle) * SpawnDistance,
-			FMath::Sin(Angle) * SpawnDistance,
-			0.0f
-		);
+	const float ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
 
-		// 生成敌人
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = 
-			ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-		SpawnParams.Owner = this;
+	// 更新统计数据
+	WaveSpawnStats.QueueDepth = GetSpawnQueueDepth();
+	WaveSpawnStats.TotalSpawned += NewEnemies.Num();
+	WaveSpawnStats.LastFrameSpawned = NewEnemies.Num();
+	WaveSpawnStats.LastFrameSpawnMs = ElapsedMs;
+	WaveSpawnStats.PeakFrameSpawnMs = FMath::Max(WaveSpawnStats.PeakFrameSpawnMs, ElapsedMs);
 
-		AEnemyBase* NewEnemy = GetWorld()->SpawnActor<AEnemyBase>(
-			EnemyClass, 
-			SpawnLocation, 
-			FRotator::ZeroRotator, 
-			SpawnParams
-		);
+	const float CostPerSpawnMs = ElapsedMs / SpawnCount;
+	WaveSpawnStats.AverageSpawnCostMs = WaveSpawnStats.AverageSpawnCostMs > 0.0f ?
+		FMath::Lerp(WaveSpawnStats.AverageSpawnCostMs, CostPerSpawnMs, 0.2f) : CostPerSpawnMs;
 
-		if (NewEnemy)
-		{
-			// 增加敌人计数
-			CurrentEnemyCount++;
+	if (SpawnBudgetMs > 0.0f && ElapsedMs > SpawnBudgetMs)
+	{
+		WaveSpawnStats.OverBudgetFrames++;
+		UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTAGameMode] 本帧生成 %d 个敌人耗时 %.2f ms，超出预算 %.2f ms"),
+		       NewEnemies.Num(), ElapsedMs, SpawnBudgetMs);
+	}
 
-			// 添加到活跃敌人列表
-			ActiveEnemies.Add(NewEnemy);
+	SET_DWORD_STAT(STAT_SDTASpawn_QueueDepth, WaveSpawnStats.QueueDepth);
+	SET_DWORD_STAT(STAT_SDTASpawn_SpawnedThisFrame, NewEnemies.Num());
+}
 
-			// 绑定敌人死亡事件
-			NewEnemy->OnEnemyDestroyed.AddDynamic(this, &ASDTAGameMode::OnEnemyDestroyed);
+/**
+ * 丢弃尚未生成的敌人
+ * 
+ * 功能：清空等待队列，白天开始或停止生成时调用，避免夜晚结束后继续生成
+ */
+void ASDTAGameMode::ClearSpawnQueue()
+{
+	const int32 Discarded = GetSpawnQueueDepth();
+	PendingSpawns.Reset();
+	NextPendingSpawn = 0;
+	WaveSpawnStats.QueueDepth = 0;
 
-			UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTAGameMode] 成功生成敌人 at %s"), 
-			       *SpawnLocation.ToString());
-		}
+	if (Discarded > 0)
+	{
+		UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 丢弃 %d 个尚未生成的敌人"), Discarded);
 	}
 }
 
+/**
+ * 记录新生成的敌人
+ * 
+ * @param Enemy 新生成的敌人
+ */
+void ASDTAGameMode::RegisterSpawnedEnemy(AEnemyBase* Enemy)
+{
+	// 增加敌人计数
+	CurrentEnemyCount++;
+
+	// 注册到活跃敌人注册表（分配新句柄，复用的池化敌人不会沿用旧句柄）
+	EnemyRegistry.Add(Enemy);
+
+	// 绑定敌人死亡事件（池化敌人会被多次获取，避免重复绑定）
+	Enemy->OnEnemyDestroyed.AddUniqueDynamic(this, &ASDTAGameMode::OnEnemyDestroyed);
+
+	UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTAGameMode] 成功生成敌人 at %s"), 
+	       *Enemy->GetActorLocation().ToString());
+}
+
 void ASDTAGameMode::StartEnemySpawning()
 {
 	// 主机权威：只在服务器端执行
 	if (!HasAuthority()) return;
 
 	// 检查是否已经在生成
-	if (GetWorld()->GetTimerManager().IsTimerActive(EnemySpawnTimer))
+	if (!WaveDirector || WaveDirector->IsNightActive())
 	{
 		return;
 	}
 
 	// 检查配置是否有效
-	if (!EnemyClass || WaveSizes.Num() == 0 || WaveIntervals.Num() == 0)
+	if (!EnemyClass && !WaveDataTable)
 	{
 		UE_LOG(LogSevenDaysToAlive, Warning, TEXT("[SDTAGameMode] 敌人生成配置不完整"));
 		return;
 	}
 
-	// 获取当前天数的生成间隔
-	int32 IntervalIndex = FMath::Min(CurrentDay - 1, WaveIntervals.Num() - 1);
-	float SpawnInterval = WaveIntervals.IsValidIndex(IntervalIndex) ? 
-		WaveIntervals[IntervalIndex] : 60.0f;
-
-	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 开始敌人生成，间隔: %.1f 秒"), 
-	       SpawnInterval);
-
-	// 设置生成定时器
-	GetWorld()->GetTimerManager().SetTimer(
-		EnemySpawnTimer,
-		this,
-		&ASDTAGameMode::SpawnEnemyWave,
-		SpawnInterval,
-		true
-	);
+	// 由波次导演在Tick中按夜晚进度增量生成
+	WaveDirector->BeginNight(CurrentDay, NightDuration, GetNumPlayers());
 }
 
 void ASDTAGameMode::StopEnemySpawning()
@@ -354,10 +644,13 @@ void ASDTAGameMode::StopEnemySpawning()
 	// 主机权威：只在服务器端执行
 	if (!HasAuthority()) return;
 
-	// 停止生成定时器
-	if (GetWorld()->GetTimerManager().IsTimerActive(EnemySpawnTimer))
+	// 丢弃尚未生成的敌人
+	ClearSpawnQueue();
+
+	// 结束波次导演的夜晚
+	if (WaveDirector && WaveDirector->IsNightActive())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(EnemySpawnTimer);
+		WaveDirector->EndNight();
 		UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 已停止敌人生成"));
 	}
 }
@@ -378,12 +671,8 @@ void ASDTAGameMode::OnEnemyDestroyed(AEnemyBase* DestroyedEnemy)
 		CurrentEnemyCount--;
 	}
 
-	// 从活跃敌人列表中移除
-	int32 EnemyIndex = ActiveEnemies.Find(DestroyedEnemy);
-	if (EnemyIndex != INDEX_NONE)
-	{
-		ActiveEnemies.RemoveAt(EnemyIndex);
-	}
+	// 从活跃敌人注册表中注销（O(1)交换删除）
+	EnemyRegistry.Remove(DestroyedEnemy);
 
 	// 收集灵魂碎片奖励（每个敌人掉落 1-3 个碎片）
 	int32 SoulReward = FMath::RandRange(1, 3);
@@ -398,25 +687,11 @@ void ASDTAGameMode::CleanupDeadEnemies()
 	// 主机权威：只在服务器端执行
 	if (!HasAuthority()) return;
 
-	TArray<AEnemyBase*> DeadEnemies;
-
-	// 找出所有无效或死亡的敌人
-	for (AEnemyBase* Enemy : ActiveEnemies)
-	{
-		if (!Enemy || Enemy->IsActorBeingDestroyed())
-		{
-			DeadEnemies.Add(Enemy);
-		}
-	}
-
-	// 移除死亡敌人
-	for (AEnemyBase* DeadEnemy : DeadEnemies)
-	{
-		ActiveEnemies.Remove(DeadEnemy);
-	}
+	// 一次遍历注销所有无效或死亡的敌人
+	EnemyRegistry.RemoveInvalid();
 
 	// 更新敌人计数
-	CurrentEnemyCount = ActiveEnemies.Num();
+	CurrentEnemyCount = EnemyRegistry.Num();
 }
 
 /**
@@ -425,8 +700,8 @@ void ASDTAGameMode::CleanupDeadEnemies()
  * 功能：在白天开始时清理场景中所有的敌人
  * 设计要点：
  * 1. 主机权威：只在服务器端执行
- * 2. 遍历所有活跃敌人并销毁
- * 3. 重置敌人计数和活跃敌人列表
+ * 2. 遍历所有活跃敌人并回收回对象池（非池化敌人直接销毁）
+ * 3. 重置敌人计数和活跃敌人注册表
  * 4. 提供视觉反馈和日志记录
  *
  * 注意：该方法通常在白天开始时调用
@@ -436,35 +711,229 @@ void ASDTAGameMode::ClearAllEnemies()
 	// 主机权威：只在服务器端执行
 	if (!HasAuthority()) return;
 
-	if (ActiveEnemies.Num() == 0)
+	if (EnemyRegistry.Num() == 0)
 	{
 		return;
 	}
 
 	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 白天开始，清理所有敌人（数量: %d）"), 
-	       ActiveEnemies.Num());
+	       EnemyRegistry.Num());
 
-	// 遍历并销毁所有敌人
-	for (AEnemyBase* Enemy : ActiveEnemies)
+	// 解绑死亡事件委托，收集需要回收的敌人
+	TArray<AEnemyBase*> EnemiesToRelease;
+	EnemiesToRelease.Reserve(EnemyRegistry.Num());
+	for (AEnemyBase* Enemy : EnemyRegistry)
 	{
 		if (Enemy && !Enemy->IsActorBeingDestroyed())
 		{
-			// 解绑死亡事件委托
 			Enemy->OnEnemyDestroyed.RemoveDynamic(this, &ASDTAGameMode::OnEnemyDestroyed);
-			
-			// 直接销毁敌人（不触发死亡事件）
-			Enemy->Destroy();
+			EnemiesToRelease.Add(Enemy);
 		}
 	}
 
-	// 清空活跃敌人列表
-	ActiveEnemies.Empty();
+	// 批量回收敌人（不触发死亡事件）
+	ReleaseEnemyBatch(EnemiesToRelease);
+
+	// 清空活跃敌人注册表（所有句柄失效）
+	EnemyRegistry.Reset();
 	
 	// 重置敌人计数
 	CurrentEnemyCount = 0;
 
 	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 所有敌人已清理完毕"));
 }
+
+/**
+ * 预热敌人对象池
+ * 
+ * 功能：在白天阶段为即将到来的夜晚分帧预创建敌人对象
+ * 设计要点：
+ * 1. 每种敌人的预热数量由波次导演按当晚的敌人总数、存活上限和组成权重估算
+ * 2. 同时存活的敌人数量不超过MaxEnemyCount，预热数量以此封顶
+ * 3. 使用对象池的异步预热，按PoolPrewarmBudgetMs分摊到白天的多帧中，避免卡顿
+ * 4. 不限制池最大容量，死亡动画期间尚未回收的敌人由对象池按需补充
+ * 
+ * @param Day 即将到来的夜晚所属天数
+ */
+void ASDTAGameMode::PrewarmEnemyPool(int32 Day)
+{
+	if (!HasAuthority() || !PoolManager || !WaveDirector)
+	{
+		return;
+	}
+
+	TMap<UClass*, int32> PrewarmCounts;
+	WaveDirector->GetExpectedPeakCounts(Day, FMath::Max(1, GetNumPlayers()), PrewarmCounts);
+
+	for (const TPair<UClass*, int32>& Pair : PrewarmCounts)
+	{
+		const int32 PrewarmCount = FMath::Min(Pair.Value, MaxEnemyCount);
+		PoolManager->PrewarmPoolAsync(Pair.Key, PrewarmCount, -1, PoolPrewarmBudgetMs);
+
+		UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 开始预热第 %d 夜敌人对象池: %s x %d"), 
+		       Day, *Pair.Key->GetName(), PrewarmCount);
+	}
+}
+
+/**
+ * 对象池预热完成回调
+ * 
+ * @param ObjectClass 完成预热的对象类型
+ * @param PoolSize 预热完成后池中对象总数
+ */
+void ASDTAGameMode::OnPoolPrewarmCompleted(UClass* ObjectClass, int32 PoolSize)
+{
+	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 对象池预热完成: %s x %d"), 
+	       ObjectClass ? *ObjectClass->GetName() : TEXT("None"), PoolSize);
+}
+
+/**
+ * 获取敌人实例
+ * 
+ * 功能：从对象池获取敌人并放置到生成位置
+ * 设计要点：
+ * 1. 对象池获取时已调用敌人的Reset，这里只负责位置和所有者
+ * 2. 使用瞬移方式放置，避免从回收位置扫掠移动
+ * 3. 对象池不可用时回退为SpawnActor，保持原有行为
+ * 
+ * @param SpawnClass 敌人类型
+ * @param SpawnLocation 生成位置
+ * @param SpawnRotation 生成朝向
+ * @return 敌人实例，失败返回nullptr
+ */
+AEnemyBase* ASDTAGameMode::AcquireEnemy(TSubclassOf<AEnemyBase> SpawnClass, const FVector& SpawnLocation, const FRotator& SpawnRotation)
+{
+	if (!SpawnClass)
+	{
+		return nullptr;
+	}
+
+	AEnemyBase* Enemy = SDTAGetPooledObject<AEnemyBase>(PoolManager, SpawnClass);
+	if (Enemy)
+	{
+		Enemy->SetOwner(this);
+		Enemy->SetActorLocationAndRotation(SpawnLocation, SpawnRotation, false, nullptr, ETeleportType::TeleportPhysics);
+		return Enemy;
+	}
+
+	// 对象池不可用，回退为直接生成
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = 
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	SpawnParams.Owner = this;
+
+	return GetWorld()->SpawnActor<AEnemyBase>(
+		SpawnClass, 
+		SpawnLocation, 
+		SpawnRotation, 
+		SpawnParams
+	);
+}
+
+/**
+ * 回收敌人实例
+ * 
+ * 功能：将敌人回收回对象池，AI寻路由敌人的OnReleasedToPool停止
+ * 设计要点：敌人不是由对象池创建时直接销毁；由对象池创建但回收被拒绝（重复回收）时保留在池中
+ * 
+ * @param Enemy 要回收的敌人
+ */
+void ASDTAGameMode::ReleaseEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	if (PoolManager && PoolManager->ReturnObject(Enemy))
+	{
+		return;
+	}
+
+	if (!PoolManager || !PoolManager->OwnsObject(Enemy))
+	{
+		Enemy->Destroy();
+	}
+}
+
+/**
+ * 批量获取敌人实例
+ * 
+ * 功能：一次性从对象池获取整波敌人并放置到各自的生成位置
+ * 设计要点：
+ * 1. 通过对象池的AcquireBatch只查找一次对象池，敌人只在最终位置显示一次
+ * 2. 对象池不可用或达到容量上限时，剩余的生成位置逐个回退为AcquireEnemy
+ * 
+ * @param SpawnClass 敌人类型
+ * @param SpawnTransforms 每个敌人的生成变换
+ * @param OutEnemies 输出参数：获取到的敌人
+ */
+void ASDTAGameMode::AcquireEnemyBatch(TSubclassOf<AEnemyBase> SpawnClass, const TArray<FTransform>& SpawnTransforms, TArray<AEnemyBase*>& OutEnemies)
+{
+	OutEnemies.Reset(SpawnTransforms.Num());
+
+	if (PoolManager && SpawnClass)
+	{
+		TArray<UObject*> PooledObjects;
+		PoolManager->AcquireBatch(SpawnClass, SpawnTransforms.Num(), SpawnTransforms, PooledObjects);
+
+		for (UObject* Object : PooledObjects)
+		{
+			AEnemyBase* Enemy = Cast<AEnemyBase>(Object);
+			if (Enemy)
+			{
+				Enemy->SetOwner(this);
+				OutEnemies.Add(Enemy);
+			}
+		}
+	}
+
+	// 对象池不足的部分逐个获取
+	for (int32 i = OutEnemies.Num(); i < SpawnTransforms.Num(); ++i)
+	{
+		const FTransform& SpawnTransform = SpawnTransforms[i];
+		if (AEnemyBase* Enemy = AcquireEnemy(SpawnClass, SpawnTransform.GetLocation(), SpawnTransform.Rotator()))
+		{
+			OutEnemies.Add(Enemy);
+		}
+	}
+}
+
+/**
+ * 批量回收敌人实例
+ * 
+ * 功能：一次性将多个敌人回收回对象池
+ * 设计要点：对象池统一停放所有敌人；不是由对象池创建的敌人直接销毁，重复回收的敌人保留在池中
+ * 
+ * @param Enemies 要回收的敌人
+ */
+void ASDTAGameMode::ReleaseEnemyBatch(const TArray<AEnemyBase*>& Enemies)
+{
+	if (!PoolManager)
+	{
+		for (AEnemyBase* Enemy : Enemies)
+		{
+			if (Enemy)
+			{
+				Enemy->Destroy();
+			}
+		}
+		return;
+	}
+
+	TArray<UObject*> Objects(Enemies);
+	TArray<UObject*> Rejected;
+	PoolManager->ReleaseBatch(Objects, Rejected);
+
+	for (UObject* Object : Rejected)
+	{
+		AActor* Actor = Cast<AActor>(Object);
+		if (Actor && !PoolManager->OwnsObject(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+}
 #pragma endregion
 
 #pragma region 资源与升级系统 - 方法声明
@@ -626,7 +1095,9 @@ void ASDTAGameMode::OnDayNightStateChanged(bool bIsNowNight)
 	ASDTAGameState* SDTAGameState = GetSDTAGameState();
 	if (SDTAGameState)
 	{
-		SDTAGameState->bIsNight = bIsNowNight;
+		// 以昼夜管理器中已经过的时间作为新锚点，客户端据此在本地计算剩余时间
+		SyncDayPhaseAnchor();
+		
 		if (!bIsNowNight)
 		{
 			CurrentDay++;
@@ -647,6 +1118,8 @@ void ASDTAGameMode::OnDayNightStateChanged(bool bIsNowNight)
 		StopEnemySpawning();
 		// 清理所有敌人
 		ClearAllEnemies();
+		// 利用白天时间分帧预热今晚的敌人对象池
+		PrewarmEnemyPool(CurrentDay);
 		// 分配灵魂碎片用于升级
 		DistributeSoulFragments();
 	}
@@ -689,6 +1162,7 @@ void ASDTAGameMode::StartGame()
 	GameTime = 0.0f;
 	CurrentDay = 1;
 	bIsNight = false;
+	SimulationClock.Reset();
 	
 	// 同时更新GameState
 	ASDTAGameState* SDTAGameState = GetSDTAGameState();
@@ -699,7 +1173,7 @@ void ASDTAGameMode::StartGame()
 		SDTAGameState->bVictory = false;
 		SDTAGameState->GameTime = 0.0f;
 		SDTAGameState->CurrentDay = 1;
-		SDTAGameState->bIsNight = false;
+		SDTAGameState->SetDayPhase(ESDTADayPhase::Day, 0.0f, SDTAGameState->GetServerWorldTimeSeconds(), SimulationClock.GetTimeScale());
 		SDTAGameState->GlobalSoulFragments = 0;
 	}
 	
@@ -774,20 +1248,11 @@ void ASDTAGameMode::BroadcastGameState()
 		TimePercent = DayNightManager->GetTimePercent();
 	}
 	
-	// 同时更新GameState
+	// 同步过渡状态到GameState（只在状态变化时写入；剩余时间和过渡进度由客户端根据阶段时间锚点在本地计算）
 	ASDTAGameState* SDTAGameState = GetSDTAGameState();
-	if (SDTAGameState)
+	if (SDTAGameState && DayNightManager)
 	{
-		SDTAGameState->RemainingTime = RemainingTime;
-		SDTAGameState->TimePercent = TimePercent;
-		
-		// 同步过渡状态
-		if (DayNightManager)
-		{
-			SDTAGameState->bIsTransitioning = DayNightManager->IsTransitioning();
-			SDTAGameState->bTransitionToNight = DayNightManager->IsTransitioningToNight();
-			SDTAGameState->TransitionProgress = DayNightManager->GetTransitionProgress();
-		}
+		SDTAGameState->SetDayNightTransition(DayNightManager->IsTransitioning(), DayNightManager->IsTransitioningToNight());
 	}
 	
 	// 遍历所有玩家控制器，更新他们的HUD
@@ -828,3 +1293,98 @@ void ASDTAGameMode::BroadcastGameState()
 }
 #pragma endregion
 
+#pragma region 武器系统 - 子弹对象池
+/**
+ * 预热子弹对象池
+ * 
+ * 功能：遍历武器数据表，为每个不同的BulletClass创建对象池
+ * 设计要点：同一子弹类被多把武器共用时只创建一个对象池
+ */
+void ASDTAGameMode::PrewarmBulletPools()
+{
+	if (!HasAuthority() || !PoolManager || !WeaponDataTable)
+	{
+		return;
+	}
+
+	TArray<FSDTAWeaponTableRow*> WeaponRows;
+	WeaponDataTable->GetAllRows<FSDTAWeaponTableRow>(TEXT("PrewarmBulletPools"), WeaponRows);
+
+	for (const FSDTAWeaponTableRow* WeaponRow : WeaponRows)
+	{
+		if (WeaponRow && WeaponRow->BulletType == ESDTABulletType::Projectile)
+		{
+			EnsureBulletPool(WeaponRow->BulletClass);
+		}
+	}
+}
+
+/**
+ * 确保子弹对象池存在
+ * 
+ * @param BulletClass 子弹类
+ */
+void ASDTAGameMode::EnsureBulletPool(TSubclassOf<ASDTABullet> BulletClass)
+{
+	if (!PoolManager || !BulletClass)
+	{
+		return;
+	}
+
+	// 已存在的对象池不会被重复初始化
+	if (PoolManager->HasPool(BulletClass))
+	{
+		return;
+	}
+
+	// 分帧预热；预热完成前开火时对象池会按需同步创建
+	PoolManager->PrewarmPoolAsync(BulletClass, BulletPoolPrewarmSize, -1, PoolPrewarmBudgetMs);
+
+	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAGameMode] 开始预热子弹对象池: %s x %d"), 
+	       *BulletClass->GetName(), BulletPoolPrewarmSize);
+}
+
+/**
+ * 获取子弹实例
+ * 
+ * 功能：从对象池借出子弹，设置所有者、发起者和发射位置
+ * 设计要点：
+ * 1. 借出时将池化句柄交给子弹，子弹回收时按句柄O(1)归还
+ * 2. 先传送到发射位置再开启碰撞，子弹不会在对象池的停放位置产生重叠或命中
+ * 3. 对象池不可用时回退为SpawnActor，子弹回收时会直接销毁
+ * 
+ * @param BulletClass 子弹类
+ * @param Location 发射位置
+ * @param Rotation 发射朝向
+ * @param BulletOwner 子弹所有者
+ * @param BulletInstigator 子弹发起者
+ * @return 子弹实例，失败返回nullptr
+ */
+ASDTABullet* ASDTAGameMode::AcquireBullet(TSubclassOf<ASDTABullet> BulletClass, const FVector& Location, const FRotator& Rotation, AActor* BulletOwner, APawn* BulletInstigator)
+{
+	if (!BulletClass)
+	{
+		return nullptr;
+	}
+
+	EnsureBulletPool(BulletClass);
+
+	// 池化句柄由子弹的OnAcquiredFromPool保存
+	ASDTABullet* Bullet = SDTAGetPooledObject<ASDTABullet>(PoolManager, BulletClass);
+	if (Bullet)
+	{
+		Bullet->SetOwner(BulletOwner);
+		Bullet->SetInstigator(BulletInstigator);
+		Bullet->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		Bullet->SetActorEnableCollision(true);
+		return Bullet;
+	}
+
+	// 对象池不可用，回退为直接生成
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = BulletOwner;
+	SpawnParams.Instigator = BulletInstigator;
+
+	return GetWorld()->SpawnActor<ASDTABullet>(BulletClass, Location, Rotation, SpawnParams);
+}
+#pragma endregion
@@ -8,13 +8,62 @@
 #include "Variant_SDTA/Core/Game/SDTAGameState.h"
 #include "Variant_SDTA/Core/Game/SDTAPlayerState.h"
 #include "Variant_SDTA/Enemies/AI/EnemyBase.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyRegistry.h"
 #include "Variant_SDTA/Core/Game/DayNight/SDTADayNightManager.h"
+#include "Variant_SDTA/Core/Game/SDTAFixedStepClock.h"
 
 /** 自定义日志类别：关键游戏事件（可在编辑器 Output Log 中设置独立颜色） */
 DECLARE_LOG_CATEGORY_EXTERN(LogKeyGameEvent, Log, All);
 
 #include "SDTAGameMode.generated.h"
 
+/**
+ * 波次生成调度统计数据
+ *
+ * 用于确认大规模夜晚的敌人生成是否控制在帧预算内
+ */
+USTRUCT(BlueprintType)
+struct SEVENDAYSTOALIVE_API FSDTAWaveSpawnStats
+{
+	GENERATED_BODY()
+
+	/** 当前等待生成的敌人数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	int32 QueueDepth = 0;
+
+	/** 等待队列长度峰值 */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	int32 PeakQueueDepth = 0;
+
+	/** 累计入队的敌人数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	int32 TotalQueued = 0;
+
+	/** 累计生成的敌人数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	int32 TotalSpawned = 0;
+
+	/** 上一个生成帧生成的敌人数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	int32 LastFrameSpawned = 0;
+
+	/** 上一个生成帧的生成耗时（毫秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	float LastFrameSpawnMs = 0.0f;
+
+	/** 单帧生成耗时峰值（毫秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	float PeakFrameSpawnMs = 0.0f;
+
+	/** 单个敌人的平均生成耗时（毫秒，指数滑动平均，用于估算每帧可生成的数量） */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	float AverageSpawnCostMs = 0.0f;
+
+	/** 生成耗时超出SpawnBudgetMs的帧数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy Spawn|Stats")
+	int32 OverBudgetFrames = 0;
+};
+
 /**
  * 七日求生游戏模式类
  * 
@@ -111,13 +160,27 @@ public:
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Day Night System|Atmosphere Configuration")
 	FName AtmosphereTag; // 大气标签
+	
+	// 曲线驱动的光照配置（配置曲线后光照随整个循环变化，配置材质参数集合后只写全局参数）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Day Night System|Light Configuration")
+	FSDTADayNightLightingProfile DayNightLighting;
+	
+	// 固定步长模拟配置（昼夜和波次按固定步长推进，不受帧率影响）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Day Night System|Simulation", meta = (ClampMin = 1, Units = "Hz"))
+	float SimulationStepRate; // 每秒模拟步数
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Day Night System|Simulation", meta = (ClampMin = 1))
+	int32 MaxSimulationSubsteps; // 卡顿帧每帧最多追赶的模拟步数
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Day Night System|Simulation", meta = (ClampMin = 0))
+	float SimulationTimeScale; // 模拟时间缩放（再乘以控制台变量 sdta.Sim.TimeScale）
 #pragma endregion
 
 #pragma region 敌人生成系统
 public:
 	// 敌人生成管理
 	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn")
-	TSubclassOf<class AEnemyBase> EnemyClass; // 敌人类型
+	TSubclassOf<class AEnemyBase> EnemyClass; // 默认敌人类型（波次数据表未指定类型时使用）
 	
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Enemy Spawn")
 	int32 CurrentEnemyCount; // 当前场景中敌人数量
@@ -125,22 +188,95 @@ public:
 	UPROPERTY(EditDefaultsOnly, Replicated, BlueprintReadWrite, Category = "Enemy Spawn")
 	int32 MaxEnemyCount; // 最大敌人数量
 	
-	// 波次生成配置
-	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn")
-	TArray<int32> WaveSizes; // 每天敌人生成数量
+	/**
+	 * 波次数据表（行类型为FSDTAWaveTableRow）
+	 *
+	 * 功能：定义每晚的敌人组成、夜晚内的生成曲线和按玩家数量的存活上限
+	 * 配置位置：GameMode蓝图 → Details面板 → Enemy Spawn
+	 * 未设置时使用默认节奏：只生成EnemyClass，敌人总数随天数线性增长
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn")
+	UDataTable* WaveDataTable;
 	
-	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn")
-	TArray<float> WaveIntervals; // 敌人生成间隔
+	// 生成点规划配置（推送给SpawnPlanner）
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner", meta = (ClampMin = 0, Units = "cm"))
+	float SpawnMinDistance; // 距离最近玩家的最小生成距离
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner", meta = (ClampMin = 0, Units = "cm"))
+	float SpawnMaxDistance; // 距离最近玩家的最大生成距离
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner", meta = (ClampMin = 100, Units = "cm"))
+	float SpawnRegionSize; // 候选点缓存区域边长
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner", meta = (ClampMin = 1))
+	int32 SpawnCandidatesPerRegion; // 每个区域的候选点数量
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner", meta = (ClampMin = 0, Units = "cm"))
+	float SpawnMinSeparation; // 同一波生成点之间的最小间距
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner", meta = (ClampMin = 0, Units = "cm"))
+	float SpawnMaxProjectionHeight; // 候选点投影的竖直范围，应小于楼层高度
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawn|Spawn Planner")
+	bool bSpawnAvoidPlayerSight; // 是否优先在玩家视线外生成
+	
+	// 分帧生成预算（波次先入队，再由Tick按预算逐帧生成）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn|Budget", meta = (ClampMin = 1))
+	int32 MaxSpawnsPerFrame; // 每帧最多生成的敌人数量
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn|Budget", meta = (ClampMin = 0, Units = "ms"))
+	float SpawnBudgetMs; // 每帧生成耗时预算，0表示只按数量限制
+	
+	// 敌人AI更新配置（推送给USDTAEnemyManager）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn|AI", meta = (ClampMin = 0, Units = "cm"))
+	float EnemyRepathDistance; // 追逐目标移动超过该距离才重新寻路
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn|AI")
+	TArray<FSDTAEnemySignificanceTier> EnemySignificanceTiers; // 敌人重要性等级，为空时使用管理器的默认等级
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn|AI", meta = (ClampMin = 1))
+	int32 EnemyMaxPathRequestsPerFrame; // 每帧最多发起的单独寻路请求数量
+	
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Spawn|AI")
+	bool bEnemyUseFlowField; // 是否启用尸潮流场导航（远离玩家的敌人共享每个玩家的流场）
+	
+	// 当前等待生成的敌人数量
+	UFUNCTION(BlueprintPure, Category = "Enemy Spawn")
+	int32 GetSpawnQueueDepth() const { return PendingSpawns.Num() - NextPendingSpawn; }
+	
+	// 波次生成调度统计
+	UFUNCTION(BlueprintPure, Category = "Enemy Spawn")
+	FSDTAWaveSpawnStats GetWaveSpawnStats() const { return WaveSpawnStats; }
 	
 	// 敌人生成逻辑
-	void SpawnEnemyWave();
+	int32 SpawnEnemyWave(int32 EnemiesToSpawn); // 规划生成点并将敌人放入等待队列，类型由波次导演选择，返回入队数量
 	void StartEnemySpawning();
 	void StopEnemySpawning();
 	
+	// 按句柄查找活跃敌人，句柄失效（敌人已死亡或被回收复用）时返回nullptr
+	UFUNCTION(BlueprintPure, Category = "Enemy Spawn")
+	AEnemyBase* ResolveEnemy(const FSDTAEnemyHandle& Handle) const { return EnemyRegistry.Resolve(Handle); }
+	
+	// 活跃敌人注册表（只读，紧凑排列，可直接遍历）
+	const FSDTAEnemyRegistry& GetEnemyRegistry() const { return EnemyRegistry; }
+	
 	// 敌人管理
 	void OnEnemyDestroyed(class AEnemyBase* DestroyedEnemy);
 	void CleanupDeadEnemies();
 	void ClearAllEnemies(); // 清理所有敌人（白天开始时调用）
+
+protected:
+	// 敌人对象池
+	void PrewarmEnemyPool(int32 Day); // 按波次配置分帧预热指定天数夜晚的敌人对象池
+	AEnemyBase* AcquireEnemy(TSubclassOf<AEnemyBase> SpawnClass, const FVector& SpawnLocation, const FRotator& SpawnRotation); // 从对象池获取敌人，无对象池时回退为SpawnActor
+	void ReleaseEnemy(AEnemyBase* Enemy); // 将敌人回收回对象池，非池化敌人直接销毁
+	void AcquireEnemyBatch(TSubclassOf<AEnemyBase> SpawnClass, const TArray<FTransform>& SpawnTransforms, TArray<AEnemyBase*>& OutEnemies); // 批量获取同一类型的敌人，对象池不足的部分逐个回退
+	void ReleaseEnemyBatch(const TArray<AEnemyBase*>& Enemies); // 批量回收敌人，非池化敌人直接销毁
+	
+	// 分帧生成调度
+	void ProcessSpawnQueue(); // 按每帧预算从等待队列生成敌人
+	void ClearSpawnQueue(); // 丢弃尚未生成的敌人（停止生成时调用）
+	void RegisterSpawnedEnemy(AEnemyBase* Enemy); // 记录新生成的敌人并绑定死亡事件
 #pragma endregion
 
 #pragma region 资源与升级系统
@@ -220,6 +356,20 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game Systems")
 	USDTAPoolManager* GetPoolManager() const;
+
+	/**
+	 * 对象池每帧预热时间预算（毫秒）
+	 * 
+	 * 功能：控制敌人和子弹对象池异步预热时每帧用于创建对象的时间上限
+	 * 配置建议：越小越平滑，但预热完成所需帧数越多
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Game Systems|Pool", meta = (ClampMin = 0.1))
+	float PoolPrewarmBudgetMs;
+
+protected:
+	// 对象池预热完成回调
+	UFUNCTION()
+	void OnPoolPrewarmCompleted(UClass* ObjectClass, int32 PoolSize);
 #pragma endregion
 
 #pragma region UI与事件系统
@@ -241,21 +391,78 @@ public:
 	 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon System")
 	UDataTable* WeaponDataTable;
+
+	/**
+	 * 每种子弹类的对象池预热数量
+	 *
+	 * 功能：游戏开始时按武器数据表中出现的每个BulletClass预创建子弹
+	 * 配置建议：约为 子弹生命周期 / 射速 × 同时开火的玩家数
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon System|Pool", meta = (ClampMin = 0))
+	int32 BulletPoolPrewarmSize;
+
+	/**
+	 * 获取子弹实例
+	 *
+	 * 功能：从对应BulletClass的对象池借出子弹并放置到发射位置
+	 * 设计要点：对象池不可用（如纯客户端）时回退为SpawnActor
+	 *
+	 * @return 子弹实例，失败返回nullptr
+	 */
+	class ASDTABullet* AcquireBullet(TSubclassOf<class ASDTABullet> BulletClass, const FVector& Location, const FRotator& Rotation, AActor* BulletOwner, APawn* BulletInstigator);
+
+protected:
+	// 按武器数据表预热所有子弹对象池
+	void PrewarmBulletPools();
+
+	// 确保指定子弹类的对象池已创建（数据表外的子弹类在首次开火时创建）
+	void EnsureBulletPool(TSubclassOf<class ASDTABullet> BulletClass);
 #pragma endregion
 
 
 
 private:
-	// 对象池管理器
+	// 对象池子系统的缓存指针（由世界持有，GameMode只负责推送配置）
 	UPROPERTY()
 	class USDTAPoolManager* PoolManager;
 	
+	// 敌人生成点规划器
+	UPROPERTY()
+	class USDTASpawnPlanner* SpawnPlanner;
+	
+	// 波次导演（按数据表决定每帧生成多少、生成什么敌人）
+	UPROPERTY()
+	class USDTAWaveDirector* WaveDirector;
+	
+	// 游戏规则层的固定步长时钟（昼夜、波次）
+	FSDTAFixedStepClock SimulationClock;
+	
+	// 推进一个模拟步
+	void StepSimulation(float StepSeconds);
+	
+	// 按昼夜管理器中的阶段进度和当前时间缩放重新设置复制给客户端的阶段时间锚点
+	void SyncDayPhaseAnchor();
+	
 	// 内部计时器
-	FTimerHandle EnemySpawnTimer;
 	FTimerHandle DayNightTimer;
 	
-	// 敌人列表
-	TArray<class AEnemyBase*> ActiveEnemies;
+	// 活跃敌人注册表（O(1)注册/注销，代数句柄）
+	UPROPERTY()
+	FSDTAEnemyRegistry EnemyRegistry;
+	
+	// 等待生成的敌人
+	struct FPendingEnemySpawn
+	{
+		FTransform Transform; // 生成变换
+		TSubclassOf<AEnemyBase> EnemyClass; // 敌人类型
+	};
+	
+	// 等待生成的敌人队列（NextPendingSpawn之前的已生成，队列清空时整体重置）
+	TArray<FPendingEnemySpawn> PendingSpawns;
+	int32 NextPendingSpawn;
+	
+	// 波次生成调度统计
+	FSDTAWaveSpawnStats WaveSpawnStats;
 	
 	// 日志输出控制
 	float LastLogTime; // 上次输出游戏状态日志的时间
@@ -8,13 +8,19 @@ ASDTAGameState::ASDTAGameState()
 	// 初始化默认值
 	bIsNight = false;	// 初始为白天
 	GameTime = 0.0f;	// 初始游戏时间为0
-	RemainingTime = 0.0f;	// 初始剩余时间为0
-	TimePercent = 0.0f;	// 初始时间百分比为0
+	CurrentPhase = ESDTADayPhase::Day;	// 初始阶段为白天
+	PhaseElapsedAtAnchor = 0.0f;	// 初始阶段已用时间为0
+	AnchorServerTime = 0.0;	// 初始锚点时间为0
+	SimulationTimeScale = 1.0f;	// 初始不缩放
+	
+	// 初始化阶段时长
+	DayDuration = 120.0f;	// 白天2分钟
+	NightDuration = 300.0f;	// 夜晚5分钟
+	TransitionDuration = 5.0f;	// 默认过渡5秒
 	
 	// 初始化过渡状态
 	bIsTransitioning = false;	// 初始不在过渡中
 	bTransitionToNight = false;	// 初始不向夜晚过渡
-	TransitionProgress = 0.0f;	// 初始过渡进度为0
 	
 	CurrentDay = 1;	// 初始为第1天
 	CurrentEnemyCount = 0;	// 初始敌人数量为0
@@ -44,19 +50,23 @@ void ASDTAGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLi
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	// 复制游戏状态属性
-	DOREPLIFETIME(ASDTAGameState, bIsNight);
 	DOREPLIFETIME(ASDTAGameState, GameTime);
-	DOREPLIFETIME(ASDTAGameState, RemainingTime);
-	DOREPLIFETIME(ASDTAGameState, TimePercent);
+	DOREPLIFETIME(ASDTAGameState, CurrentPhase);
+	DOREPLIFETIME(ASDTAGameState, PhaseElapsedAtAnchor);
+	DOREPLIFETIME(ASDTAGameState, AnchorServerTime);
+	DOREPLIFETIME(ASDTAGameState, SimulationTimeScale);
+	DOREPLIFETIME(ASDTAGameState, DayDuration);
+	DOREPLIFETIME(ASDTAGameState, NightDuration);
+	DOREPLIFETIME(ASDTAGameState, TransitionDuration);
 	DOREPLIFETIME(ASDTAGameState, bIsTransitioning);
 	DOREPLIFETIME(ASDTAGameState, bTransitionToNight);
-	DOREPLIFETIME(ASDTAGameState, TransitionProgress);
 	DOREPLIFETIME(ASDTAGameState, DayLightIntensity);
 	DOREPLIFETIME(ASDTAGameState, NightLightIntensity);
 	DOREPLIFETIME(ASDTAGameState, DayLightColor);
 	DOREPLIFETIME(ASDTAGameState, NightLightColor);
 	DOREPLIFETIME(ASDTAGameState, DayAtmosphereColor);
 	DOREPLIFETIME(ASDTAGameState, NightAtmosphereColor);
+	DOREPLIFETIME(ASDTAGameState, LightingProfile);
 	DOREPLIFETIME(ASDTAGameState, CurrentDay);
 	DOREPLIFETIME(ASDTAGameState, CurrentEnemyCount);
 	DOREPLIFETIME(ASDTAGameState, MaxEnemyCount);
@@ -69,3 +79,95 @@ void ASDTAGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLi
 	DOREPLIFETIME(ASDTAGameState, bVictory);
 	DOREPLIFETIME(ASDTAGameState, WeaponDataTable);
 }
+
+void ASDTAGameState::OnRep_DayNightTransition()
+{
+	// 同一次复制中多个属性变化时，回调会在所有属性写入之后调用
+	bIsNight = CurrentPhase == ESDTADayPhase::Night;
+	OnDayNightTransitionStateChanged.Broadcast();
+}
+
+void ASDTAGameState::SetDayPhase(ESDTADayPhase InPhase, float InPhaseElapsed, double InAnchorServerTime, float InTimeScale)
+{
+	const bool bPhaseChanged = CurrentPhase != InPhase;
+
+	CurrentPhase = InPhase;
+	PhaseElapsedAtAnchor = FMath::Max(InPhaseElapsed, 0.0f);
+	AnchorServerTime = InAnchorServerTime;
+	SimulationTimeScale = FMath::Max(InTimeScale, 0.0f);
+	bIsNight = CurrentPhase == ESDTADayPhase::Night;
+
+	// 服务器上不会触发复制回调，手动广播
+	if (bPhaseChanged)
+	{
+		OnRep_DayNightTransition();
+	}
+}
+
+void ASDTAGameState::SetPhaseDurations(float InDayDuration, float InNightDuration, float InTransitionDuration)
+{
+	DayDuration = InDayDuration;
+	NightDuration = InNightDuration;
+	TransitionDuration = InTransitionDuration;
+}
+
+void ASDTAGameState::SetDayNightTransition(bool bInIsTransitioning, bool bInTransitionToNight)
+{
+	if (bIsTransitioning == bInIsTransitioning && bTransitionToNight == bInTransitionToNight)
+	{
+		return;
+	}
+
+	bIsTransitioning = bInIsTransitioning;
+	bTransitionToNight = bInTransitionToNight;
+
+	// 服务器上不会触发复制回调，手动广播
+	OnRep_DayNightTransition();
+}
+
+float ASDTAGameState::GetLocalTransitionProgress() const
+{
+	if (!bIsTransitioning || TransitionDuration <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	// 过渡与阶段同时开始
+	return FMath::Clamp(GetPhaseElapsedTime() / TransitionDuration, 0.0f, 1.0f);
+}
+
+float ASDTAGameState::GetPhaseDuration() const
+{
+	return CurrentPhase == ESDTADayPhase::Night ? NightDuration : DayDuration;
+}
+
+float ASDTAGameState::GetPhaseElapsedTime() const
+{
+	// 从锚点开始按缩放推进，缩放为0时停在锚点处
+	const double Elapsed = PhaseElapsedAtAnchor + (GetServerWorldTimeSeconds() - AnchorServerTime) * SimulationTimeScale;
+	return FMath::Clamp(static_cast<float>(Elapsed), 0.0f, GetPhaseDuration());
+}
+
+float ASDTAGameState::GetRemainingTime() const
+{
+	return FMath::Max(0.0f, GetPhaseDuration() - GetPhaseElapsedTime());
+}
+
+float ASDTAGameState::GetTimePercent() const
+{
+	const float Duration = GetPhaseDuration();
+	return Duration > 0.0f ? FMath::Clamp(GetRemainingTime() / Duration, 0.0f, 1.0f) : 0.0f;
+}
+
+float ASDTAGameState::GetCycleProgress() const
+{
+	const float TotalCycleDuration = DayDuration + NightDuration;
+	if (TotalCycleDuration <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// 夜晚阶段排在白天之后
+	const float CycleTime = (CurrentPhase == ESDTADayPhase::Night ? DayDuration : 0.0f) + GetPhaseElapsedTime();
+	return FMath::Clamp(CycleTime / TotalCycleDuration, 0.0f, 1.0f);
+}
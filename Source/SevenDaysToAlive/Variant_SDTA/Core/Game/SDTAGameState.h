@@ -5,8 +5,22 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameState.h"
 #include "Engine/DataTable.h"
+#include "Variant_SDTA/Core/Game/DayNight/SDTADayNightLighting.h"
 #include "SDTAGameState.generated.h"
 
+// 昼夜过渡状态变化事件（复制回调和服务器本地修改时都会广播）
+DECLARE_MULTICAST_DELEGATE(FOnDayNightTransitionStateChanged);
+
+/**
+ * 昼夜阶段
+ */
+UENUM(BlueprintType)
+enum class ESDTADayPhase : uint8
+{
+	Day UMETA(DisplayName = "Day", Tooltip = "白天"),
+	Night UMETA(DisplayName = "Night", Tooltip = "夜晚")
+};
+
 /**
  * 七日求生游戏状态类
  * 
@@ -27,31 +41,135 @@ protected:
 	virtual void BeginPlay() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	// 昼夜或过渡状态在网络上复制时调用
+	UFUNCTION()
+	void OnRep_DayNightTransition();
+
 public:
-	// 昼夜状态
-	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Game State")
+	/**
+	 * 设置昼夜阶段（仅服务器调用）
+	 * 
+	 * 功能：记录阶段和一个时间锚点（锚点时刻的阶段已用时间、锚点的服务器世界时间）以及时间缩放，
+	 *       客户端按 锚点已用时间 + (服务器时间 - 锚点时间) × 缩放 在本地计算剩余时间和过渡进度，
+	 *       不再每帧复制剩余时间、时间百分比和过渡进度
+	 * 设计要点：时间缩放为0时已用时间停在锚点处，不需要除以缩放回推阶段开始时间
+	 * 
+	 * @param InPhase 昼夜阶段
+	 * @param InPhaseElapsed 锚点时刻当前阶段已经过的模拟时间（秒）
+	 * @param InAnchorServerTime 锚点的服务器世界时间（秒）
+	 * @param InTimeScale 锚点之后的模拟时间缩放
+	 */
+	void SetDayPhase(ESDTADayPhase InPhase, float InPhaseElapsed, double InAnchorServerTime, float InTimeScale);
+
+	/**
+	 * 设置阶段时长（仅服务器调用）
+	 * 
+	 * @param InDayDuration 白天持续时间（秒）
+	 * @param InNightDuration 夜晚持续时间（秒）
+	 * @param InTransitionDuration 过渡持续时间（秒）
+	 */
+	void SetPhaseDurations(float InDayDuration, float InNightDuration, float InTransitionDuration);
+
+	/**
+	 * 设置过渡状态（仅服务器调用）
+	 * 
+	 * 功能：状态变化时广播过渡状态变化事件，过渡从阶段开始时计时
+	 * 
+	 * @param bInIsTransitioning 是否正在过渡
+	 * @param bInTransitionToNight 是否过渡到夜晚
+	 */
+	void SetDayNightTransition(bool bInIsTransitioning, bool bInTransitionToNight);
+
+	/**
+	 * 根据时间锚点在本地计算过渡进度
+	 * 
+	 * @return 过渡进度（0-1），未在过渡时返回1
+	 */
+	float GetLocalTransitionProgress() const;
+
+	/**
+	 * 获取当前阶段的持续时间
+	 * 
+	 * @return 持续时间（秒）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Day Night")
+	float GetPhaseDuration() const;
+
+	/**
+	 * 根据时间锚点在本地计算当前阶段已经过的时间
+	 * 
+	 * @return 已经过的时间（秒），不超过阶段持续时间
+	 */
+	UFUNCTION(BlueprintPure, Category = "Day Night")
+	float GetPhaseElapsedTime() const;
+
+	/**
+	 * 根据时间锚点在本地计算当前阶段的剩余时间
+	 * 
+	 * @return 剩余时间（秒）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Day Night")
+	float GetRemainingTime() const;
+
+	/**
+	 * 根据时间锚点在本地计算时间百分比
+	 * 
+	 * @return 剩余时间占阶段持续时间的比例（1-0）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Day Night")
+	float GetTimePercent() const;
+
+	/**
+	 * 根据时间锚点在本地计算昼夜循环进度
+	 * 
+	 * @return 昼夜循环进度（0-1，0为白天开始），用于对光照曲线求值
+	 */
+	UFUNCTION(BlueprintPure, Category = "Day Night")
+	float GetCycleProgress() const;
+
+	// 昼夜过渡状态变化事件
+	FOnDayNightTransitionStateChanged OnDayNightTransitionStateChanged;
+
+	// 昼夜状态（由CurrentPhase派生，不单独复制）
+	UPROPERTY(BlueprintReadOnly, Category = "Game State")
 	bool bIsNight;
 
+	// 当前昼夜阶段
+	UPROPERTY(ReplicatedUsing = OnRep_DayNightTransition, BlueprintReadOnly, Category = "Day Night")
+	ESDTADayPhase CurrentPhase;
+
+	// 锚点时刻当前阶段已经过的模拟时间（秒）
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
+	float PhaseElapsedAtAnchor;
+
+	// 时间锚点的服务器世界时间（秒）
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
+	double AnchorServerTime;
+
+	// 游戏规则层的模拟时间缩放（阶段已用时间 = 锚点已用时间 + (服务器时间 - 锚点时间) × 缩放）
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
+	float SimulationTimeScale;
+
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Game State")
 	float GameTime;
 
-	// 昼夜管理器时间数据
+	// 阶段时长（只在配置变化时复制）
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
-	float RemainingTime;
+	float DayDuration;
 
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
-	float TimePercent;
+	float NightDuration;
 
-	// 过渡状态
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
+	float TransitionDuration;
+
+	// 过渡状态
+	UPROPERTY(ReplicatedUsing = OnRep_DayNightTransition, BlueprintReadOnly, Category = "Day Night")
 	bool bIsTransitioning;
 
-	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
+	UPROPERTY(ReplicatedUsing = OnRep_DayNightTransition, BlueprintReadOnly, Category = "Day Night")
 	bool bTransitionToNight;
 
-	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night")
-	float TransitionProgress;
-
 	// 昼夜管理器配置参数
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night Configuration")
 	float DayLightIntensity;
@@ -71,6 +189,10 @@ public:
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night Configuration")
 	FLinearColor NightAtmosphereColor;
 
+	// 曲线驱动的光照配置（曲线和材质参数集合为资源引用）
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day Night Configuration")
+	FSDTADayNightLightingProfile LightingProfile;
+
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Game State")
 	int32 CurrentDay;
 
@@ -0,0 +1,441 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTASpawnPlanner.cpp - 敌人生成点规划器实现文件
+ *
+ * 实现细节：
+ * - 区域按RegionSize划分XY平面，区域内的候选点以区域坐标为随机种子抖动采样后投影到导航网格
+ * - 规划时按最近玩家将候选点分桶，桶内按分数排序后各玩家轮流取点
+ * - 分数以距离最近玩家的理想距离（最小与最大生成距离的中点）为基准，并加入随机扰动使每波位置不同
+ * - 视线内的候选点只作为备选，候选点不足时才使用
+ * - 导航网格生成完成（包括运行时动态重建）时只清空区域缓存，已规划但未取出的生成点保留到本波结束
+ */
+
+#include "Variant_SDTA/Core/Game/Spawn/SDTASpawnPlanner.h"
+#include "SevenDaysToAlive.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "NavigationSystem.h"
+
+USDTASpawnPlanner::USDTASpawnPlanner()
+	: MinSpawnDistance(500.0f)
+	, MaxSpawnDistance(1500.0f)
+	, RegionSize(1000.0f)
+	, CandidatesPerRegion(8)
+	, MinSeparation(120.0f)
+	, MaxProjectionHeight(200.0f)
+	, SpawnHeightOffset(90.0f)
+	, bAvoidPlayerSight(true)
+	, MaxSightTracesPerWave(64)
+	, World(nullptr)
+	, NextPlannedSpawn(0)
+{
+}
+
+/**
+ * 初始化生成点规划器
+ *
+ * @param InWorld 游戏世界指针
+ */
+void USDTASpawnPlanner::Initialize(UWorld* InWorld)
+{
+	World = InWorld;
+	InvalidateCache();
+	PlannedSpawns.Reset();
+	NextPlannedSpawn = 0;
+
+	// 导航网格（重新）生成后，缓存的候选点可能已不在导航网格上
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &USDTASpawnPlanner::HandleNavigationGenerationFinished);
+	}
+}
+
+/**
+ * 清空候选点缓存
+ *
+ * 功能：丢弃所有区域的候选点，下次规划时重新投影
+ */
+void USDTASpawnPlanner::InvalidateCache()
+{
+	RegionCache.Empty();
+}
+
+void USDTASpawnPlanner::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTASpawnPlanner] 导航网格生成完成，清空 %d 个区域的候选点缓存"), RegionCache.Num());
+	InvalidateCache();
+}
+
+/**
+ * 规划一波敌人的生成点
+ *
+ * 功能：为所有玩家周围的候选点打分，选出本波的生成变换
+ * 设计要点：
+ * 1. 候选点按最近玩家分桶，各玩家轮流取点，敌人均匀分布在所有玩家周围
+ * 2. 选中的点之间保持MinSeparation间距，避免生成时重叠
+ * 3. 视线检测次数受MaxSightTracesPerWave限制，视线内的点作为备选
+ *
+ * @param Count 需要的生成点数量
+ * @return 实际规划的生成点数量
+ */
+int32 USDTASpawnPlanner::PlanWave(int32 Count)
+{
+	PlannedSpawns.Reset(Count);
+	NextPlannedSpawn = 0;
+
+	if (!World || Count <= 0)
+	{
+		return 0;
+	}
+
+	GatherPlayers();
+	if (PlayerLocations.Num() == 0)
+	{
+		return 0;
+	}
+
+	EnsureRegionsAroundPlayers();
+
+	const float MinDistSq = FMath::Square(MinSpawnDistance);
+	const float MaxDistSq = FMath::Square(MaxSpawnDistance);
+	const float IdealDistance = (MinSpawnDistance + MaxSpawnDistance) * 0.5f;
+	const float ScoreJitter = (MaxSpawnDistance - MinSpawnDistance) * 0.5f;
+	const int32 RegionRadius = FMath::CeilToInt(MaxSpawnDistance / RegionSize);
+
+	// 按最近玩家为候选点分桶并打分
+	TArray<TArray<FScoredCandidate>> Buckets;
+	Buckets.SetNum(PlayerLocations.Num());
+
+	TSet<FIntPoint> VisitedRegions;
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		const FIntPoint Center = GetRegionCoord(PlayerLocation);
+		for (int32 X = Center.X - RegionRadius; X <= Center.X + RegionRadius; ++X)
+		{
+			for (int32 Y = Center.Y - RegionRadius; Y <= Center.Y + RegionRadius; ++Y)
+			{
+				const FIntPoint RegionCoord(X, Y);
+				bool bAlreadyVisited = false;
+				VisitedRegions.Add(RegionCoord, &bAlreadyVisited);
+				if (bAlreadyVisited)
+				{
+					continue;
+				}
+
+				const FSpawnRegion* Region = RegionCache.Find(RegionCoord);
+				if (!Region)
+				{
+					continue;
+				}
+
+				for (const FVector& Candidate : Region->Candidates)
+				{
+					// 找到最近的玩家，同时保证与所有玩家的距离都不小于最小生成距离
+					int32 NearestPlayer = INDEX_NONE;
+					float NearestDistSq = TNumericLimits<float>::Max();
+					for (int32 PlayerIndex = 0; PlayerIndex < PlayerLocations.Num(); ++PlayerIndex)
+					{
+						const float DistSq = FVector::DistSquared2D(Candidate, PlayerLocations[PlayerIndex]);
+						if (DistSq < NearestDistSq)
+						{
+							NearestDistSq = DistSq;
+							NearestPlayer = PlayerIndex;
+						}
+					}
+
+					if (NearestDistSq < MinDistSq || NearestDistSq > MaxDistSq)
+					{
+						continue;
+					}
+
+					FScoredCandidate& Scored = Buckets[NearestPlayer].AddDefaulted_GetRef();
+					Scored.Location = Candidate;
+					Scored.Score = FMath::FRandRange(0.0f, ScoreJitter) - FMath::Abs(FMath::Sqrt(NearestDistSq) - IdealDistance);
+					Scored.NearestPlayer = NearestPlayer;
+				}
+			}
+		}
+	}
+
+	for (TArray<FScoredCandidate>& Bucket : Buckets)
+	{
+		Bucket.Sort([](const FScoredCandidate& A, const FScoredCandidate& B) { return A.Score > B.Score; });
+	}
+
+	// 各玩家轮流取点
+	TArray<int32> Cursors;
+	Cursors.SetNumZeroed(Buckets.Num());
+	TArray<FScoredCandidate> InSightCandidates;
+	int32 SightTraces = 0;
+
+	bool bAnyRemaining = true;
+	while (PlannedSpawns.Num() < Count && bAnyRemaining)
+	{
+		bAnyRemaining = false;
+		for (int32 BucketIndex = 0; BucketIndex < Buckets.Num() && PlannedSpawns.Num() < Count; ++BucketIndex)
+		{
+			const TArray<FScoredCandidate>& Bucket = Buckets[BucketIndex];
+			int32& Cursor = Cursors[BucketIndex];
+
+			// 跳过与已选点过近的候选点，直到取到一个可用的点
+			while (Cursor < Bucket.Num())
+			{
+				const FScoredCandidate& Candidate = Bucket[Cursor++];
+				if (!IsSeparatedFromPlanned(Candidate.Location))
+				{
+					continue;
+				}
+
+				if (bAvoidPlayerSight && SightTraces < MaxSightTracesPerWave)
+				{
+					SightTraces++;
+					if (IsVisibleToAnyPlayer(Candidate.Location))
+					{
+						InSightCandidates.Add(Candidate);
+						continue;
+					}
+				}
+
+				AddPlannedSpawn(Candidate);
+				break;
+			}
+
+			bAnyRemaining |= Cursor < Bucket.Num();
+		}
+	}
+
+	// 视线外的点不足时使用视线内的点
+	for (const FScoredCandidate& Candidate : InSightCandidates)
+	{
+		if (PlannedSpawns.Num() >= Count)
+		{
+			break;
+		}
+
+		if (IsSeparatedFromPlanned(Candidate.Location))
+		{
+			AddPlannedSpawn(Candidate);
+		}
+	}
+
+	PlayerPawns.Reset();
+
+	UE_LOG(LogSevenDaysToAlive, Verbose, TEXT("[SDTASpawnPlanner] 规划生成点 %d / %d（玩家 %d，缓存区域 %d，视线检测 %d）"),
+	       PlannedSpawns.Num(), Count, PlayerLocations.Num(), RegionCache.Num(), SightTraces);
+
+	return PlannedSpawns.Num();
+}
+
+/**
+ * 取出下一个已规划的生成变换
+ *
+ * @param OutTransform 输出参数：生成变换
+ * @return 还有剩余生成点时返回true
+ */
+bool USDTASpawnPlanner::PopSpawnTransform(FTransform& OutTransform)
+{
+	if (!PlannedSpawns.IsValidIndex(NextPlannedSpawn))
+	{
+		return false;
+	}
+
+	OutTransform = PlannedSpawns[NextPlannedSpawn++];
+	return true;
+}
+
+/**
+ * 收集所有已连接玩家的位置和视点
+ *
+ * 功能：遍历所有玩家控制器，记录拥有Pawn的玩家
+ */
+void USDTASpawnPlanner::GatherPlayers()
+{
+	PlayerLocations.Reset();
+	PlayerViewPoints.Reset();
+	PlayerPawns.Reset();
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (!PlayerPawn)
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerPawn->GetActorEyesViewPoint(ViewLocation, ViewRotation);
+
+		PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		PlayerViewPoints.Add(ViewLocation);
+		PlayerPawns.Add(PlayerPawn);
+	}
+}
+
+/**
+ * 确保玩家生成范围内的区域都已缓存候选点
+ *
+ * 功能：遍历每个玩家周围覆盖最大生成距离的区域，为尚未缓存的区域投影候选点
+ * 设计要点：导航系统不可用时不写入缓存；没有候选点的区域同样写入缓存，
+ *           避免每波都重新投影，导航网格（重新）生成完成后缓存被清空，这些区域会重新投影
+ */
+void USDTASpawnPlanner::EnsureRegionsAroundPlayers()
+{
+	if (!FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		return;
+	}
+
+	const int32 RegionRadius = FMath::CeilToInt(MaxSpawnDistance / RegionSize);
+
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		const FIntPoint Center = GetRegionCoord(PlayerLocation);
+		for (int32 X = Center.X - RegionRadius; X <= Center.X + RegionRadius; ++X)
+		{
+			for (int32 Y = Center.Y - RegionRadius; Y <= Center.Y + RegionRadius; ++Y)
+			{
+				const FIntPoint RegionCoord(X, Y);
+				if (!RegionCache.Contains(RegionCoord))
+				{
+					BuildRegion(RegionCoord, PlayerLocation.Z, RegionCache.Add(RegionCoord));
+				}
+			}
+		}
+	}
+}
+
+/**
+ * 为区域投影候选点
+ *
+ * 功能：在区域内按网格抖动采样，投影到导航网格后作为候选点
+ * 设计要点：
+ * 1. 以区域坐标为随机种子，同一区域每次构建的结果一致；过近的候选点会被去重
+ * 2. 投影的竖直范围限制为MaxProjectionHeight，不会投影到参考高度上下的其他楼层
+ *
+ * @param RegionCoord 区域坐标
+ * @param ReferenceZ 投影的参考高度（触发构建的玩家高度）
+ * @param OutRegion 输出参数：区域候选点缓存
+ */
+void USDTASpawnPlanner::BuildRegion(const FIntPoint& RegionCoord, float ReferenceZ, FSpawnRegion& OutRegion) const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+	{
+		return;
+	}
+
+	FRandomStream RandomStream(GetTypeHash(RegionCoord));
+
+	// 将区域划分为近似正方形的子格，每个子格采样一个点
+	const int32 CellsPerSide = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(CandidatesPerRegion))));
+	const float CellSize = RegionSize / CellsPerSide;
+	const FVector RegionOrigin(RegionCoord.X * RegionSize, RegionCoord.Y * RegionSize, ReferenceZ);
+	const FVector QueryExtent(CellSize * 0.5f, CellSize * 0.5f, MaxProjectionHeight);
+	const float MinSeparationSq = FMath::Square(MinSeparation);
+
+	OutRegion.Candidates.Reserve(CandidatesPerRegion);
+	for (int32 i = 0; i < CandidatesPerRegion; ++i)
+	{
+		const int32 CellX = i % CellsPerSide;
+		const int32 CellY = i / CellsPerSide;
+		const FVector SamplePoint = RegionOrigin + FVector(
+			(CellX + RandomStream.FRandRange(0.25f, 0.75f)) * CellSize,
+			(CellY + RandomStream.FRandRange(0.25f, 0.75f)) * CellSize,
+			0.0f);
+
+		FNavLocation NavLocation;
+		if (!NavSys->ProjectPointToNavigation(SamplePoint, NavLocation, QueryExtent))
+		{
+			continue;
+		}
+
+		const bool bTooClose = OutRegion.Candidates.ContainsByPredicate([&](const FVector& Existing)
+		{
+			return FVector::DistSquared(Existing, NavLocation.Location) < MinSeparationSq;
+		});
+
+		if (!bTooClose)
+		{
+			OutRegion.Candidates.Add(NavLocation.Location);
+		}
+	}
+}
+
+/**
+ * 位置所在区域的坐标
+ *
+ * @param Location 世界位置
+ * @return 区域坐标
+ */
+FIntPoint USDTASpawnPlanner::GetRegionCoord(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / RegionSize), FMath::FloorToInt(Location.Y / RegionSize));
+}
+
+/**
+ * 候选点是否在任一玩家视线内
+ *
+ * 功能：从每个玩家的视点向生成点（抬高到敌人中心）做视线检测
+ *
+ * @param SpawnLocation 候选点位置
+ * @return 任一玩家的视线未被遮挡时返回true
+ */
+bool USDTASpawnPlanner::IsVisibleToAnyPlayer(const FVector& SpawnLocation) const
+{
+	const FVector Target = SpawnLocation + FVector(0.0f, 0.0f, SpawnHeightOffset);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SDTASpawnSight), false);
+	QueryParams.AddIgnoredActors(PlayerPawns);
+
+	for (const FVector& ViewPoint : PlayerViewPoints)
+	{
+		if (!World->LineTraceTestByChannel(ViewPoint, Target, ECC_Visibility, QueryParams))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * 候选点与已选生成点是否保持了最小间距
+ *
+ * @param Location 候选点位置
+ * @return 与所有已选生成点的距离都不小于MinSeparation时返回true
+ */
+bool USDTASpawnPlanner::IsSeparatedFromPlanned(const FVector& Location) const
+{
+	const float MinSeparationSq = FMath::Square(MinSeparation);
+	const FVector SpawnLocation = Location + FVector(0.0f, 0.0f, SpawnHeightOffset);
+
+	for (const FTransform& Planned : PlannedSpawns)
+	{
+		if (FVector::DistSquared(Planned.GetLocation(), SpawnLocation) < MinSeparationSq)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * 添加一个规划的生成变换
+ *
+ * 功能：将候选点抬高到敌人中心高度，并使敌人朝向最近的玩家
+ *
+ * @param Candidate 选中的候选点
+ */
+void USDTASpawnPlanner::AddPlannedSpawn(const FScoredCandidate& Candidate)
+{
+	const FVector SpawnLocation = Candidate.Location + FVector(0.0f, 0.0f, SpawnHeightOffset);
+	const FVector ToPlayer = PlayerLocations[Candidate.NearestPlayer] - SpawnLocation;
+	const FRotator SpawnRotation(0.0f, ToPlayer.Rotation().Yaw, 0.0f);
+
+	PlannedSpawns.Emplace(SpawnRotation, SpawnLocation);
+}
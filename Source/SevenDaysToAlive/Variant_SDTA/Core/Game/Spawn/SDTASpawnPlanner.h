@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SDTASpawnPlanner.generated.h"
+
+/**
+ * 敌人生成点规划器
+ *
+ * 核心功能：
+ * 1. 按区域（XY平面网格）预计算并缓存投影到导航网格上的候选生成点
+ * 2. 针对所有已连接玩家为候选点打分，按玩家轮流分配，避免敌人只围绕第一个玩家生成
+ * 3. 波次开始前一次性规划整波的生成变换，波次中以O(1)逐个取出
+ *
+ * 设计要点：
+ * - 候选点只在区域首次进入玩家生成范围时投影一次，之后直接复用缓存
+ * - 导航网格生成完成后清空缓存，之前没有候选点的区域会重新投影
+ * - 候选点只在玩家高度上下MaxProjectionHeight范围内投影，不会落到其他楼层
+ * - 同一波的生成点之间保持最小间距，生成时不再依赖碰撞修正
+ * - 优先选择玩家视线之外的点，视线检测次数受预算限制
+ *
+ * 使用说明：
+ * - 由GameMode创建并推送配置，随后调用Initialize
+ * - 每波调用PlanWave，然后循环调用PopSpawnTransform直到返回false
+ */
+UCLASS(BlueprintType)
+class SEVENDAYSTOALIVE_API USDTASpawnPlanner : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	USDTASpawnPlanner();
+
+	/**
+	 * 初始化生成点规划器
+	 *
+	 * @param InWorld 游戏世界指针
+	 */
+	void Initialize(UWorld* InWorld);
+
+	/**
+	 * 规划一波敌人的生成点
+	 *
+	 * 功能：收集所有玩家位置，补全玩家周围区域的候选点缓存，打分并选出生成变换
+	 *
+	 * @param Count 需要的生成点数量
+	 * @return 实际规划的生成点数量（候选点不足时可能少于Count）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Spawn")
+	int32 PlanWave(int32 Count);
+
+	/**
+	 * 取出下一个已规划的生成变换
+	 *
+	 * @param OutTransform 输出：生成变换（位置已抬高SpawnHeightOffset，朝向最近的玩家）
+	 * @return 还有剩余生成点时返回true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Spawn")
+	bool PopSpawnTransform(FTransform& OutTransform);
+
+	/**
+	 * 当前剩余的已规划生成点数量
+	 */
+	UFUNCTION(BlueprintPure, Category = "Enemy Spawn")
+	int32 GetRemainingSpawnCount() const { return PlannedSpawns.Num() - NextPlannedSpawn; }
+
+	/**
+	 * 清空候选点缓存（导航网格变化后调用）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Spawn")
+	void InvalidateCache();
+
+	/** 导航网格生成完成时清空候选点缓存 */
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(class ANavigationData* NavData);
+
+public:
+	/** 距离最近玩家的最小生成距离 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 0, Units = "cm"))
+	float MinSpawnDistance;
+
+	/** 距离最近玩家的最大生成距离 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 0, Units = "cm"))
+	float MaxSpawnDistance;
+
+	/** 候选点缓存区域的边长 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 100, Units = "cm"))
+	float RegionSize;
+
+	/** 每个区域投影的候选点数量 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 1))
+	int32 CandidatesPerRegion;
+
+	/** 同一波生成点之间的最小间距，应不小于敌人胶囊体直径 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 0, Units = "cm"))
+	float MinSeparation;
+
+	/** 候选点投影到导航网格时允许的竖直偏差（相对触发构建的玩家高度），应小于楼层高度 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 0, Units = "cm"))
+	float MaxProjectionHeight;
+
+	/** 生成点相对导航网格表面的抬高距离（通常为敌人胶囊体半高） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 0, Units = "cm"))
+	float SpawnHeightOffset;
+
+	/** 是否优先选择玩家视线之外的生成点 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn")
+	bool bAvoidPlayerSight;
+
+	/** 每次规划最多执行的视线检测次数 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Spawn", meta = (ClampMin = 0))
+	int32 MaxSightTracesPerWave;
+
+protected:
+	/**
+	 * 区域候选点缓存
+	 */
+	struct FSpawnRegion
+	{
+		TArray<FVector> Candidates; // 已投影到导航网格上的候选点
+	};
+
+	/**
+	 * 打分后的候选点
+	 */
+	struct FScoredCandidate
+	{
+		FVector Location; // 候选点位置（导航网格表面）
+		float Score; // 分数，越高越优先
+		int32 NearestPlayer; // 最近玩家的索引
+	};
+
+	/** 收集所有已连接玩家的位置和视点 */
+	void GatherPlayers();
+
+	/** 确保玩家生成范围内的区域都已缓存候选点 */
+	void EnsureRegionsAroundPlayers();
+
+	/** 为区域投影候选点，ReferenceZ为投影的参考高度 */
+	void BuildRegion(const FIntPoint& RegionCoord, float ReferenceZ, FSpawnRegion& OutRegion) const;
+
+	/** 位置所在区域的坐标 */
+	FIntPoint GetRegionCoord(const FVector& Location) const;
+
+	/** 候选点是否在任一玩家视线内 */
+	bool IsVisibleToAnyPlayer(const FVector& SpawnLocation) const;
+
+	/** 候选点与已选生成点是否保持了最小间距 */
+	bool IsSeparatedFromPlanned(const FVector& Location) const;
+
+	/** 添加一个规划的生成变换（朝向最近的玩家） */
+	void AddPlannedSpawn(const FScoredCandidate& Candidate);
+
+protected:
+	/** 世界上下文 */
+	UPROPERTY()
+	UWorld* World;
+
+	/** 区域坐标到候选点缓存的映射 */
+	TMap<FIntPoint, FSpawnRegion> RegionCache;
+
+	/** 本次规划时的玩家位置 */
+	TArray<FVector> PlayerLocations;
+
+	/** 本次规划时的玩家视点（用于视线检测） */
+	TArray<FVector> PlayerViewPoints;
+
+	/** 本次规划时的玩家Pawn（视线检测时忽略），只在PlanWave期间有效 */
+	TArray<const AActor*> PlayerPawns;
+
+	/** 已规划的生成变换 */
+	TArray<FTransform> PlannedSpawns;
+
+	/** 下一个要取出的生成变换索引 */
+	int32 NextPlannedSpawn;
+};
@@ -0,0 +1,293 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAWaveDirector.cpp - 波次导演实现文件
+ *
+ * 实现细节：
+ * - 生成曲线给出截至某一夜晚进度应生成的敌人比例，与已生成数量的差值即为当前欠下的生成数量
+ * - 受存活上限限制而未生成的敌人会累积，在敌人死亡腾出名额后补上
+ * - 敌人类型按累积权重二分查找选择
+ */
+
+#include "Variant_SDTA/Core/Game/Spawn/SDTAWaveDirector.h"
+#include "Variant_SDTA/Enemies/AI/EnemyBase.h"
+#include "SevenDaysToAlive.h"
+#include "Algo/BinarySearch.h"
+
+USDTAWaveDirector::USDTAWaveDirector()
+	: MinEmitBatch(3)
+	, MaxEmitInterval(2.0f)
+	, DefaultEnemiesPerDay(15)
+	, WaveTable(nullptr)
+	, MaxEnemyCount(20)
+	, bNightActive(false)
+	, NightDuration(0.0f)
+	, NightElapsed(0.0f)
+	, TimeSinceLastEmit(0.0f)
+	, TargetThisNight(0)
+	, SpawnedThisNight(0)
+{
+}
+
+/**
+ * 初始化波次导演
+ *
+ * 功能：读取数据表的所有行并按Day升序缓存
+ *
+ * @param InWaveTable 波次数据表，可为空
+ * @param InDefaultEnemyClass 默认敌人类型
+ * @param InMaxEnemyCount 全局同时存活敌人上限
+ */
+void USDTAWaveDirector::Initialize(UDataTable* InWaveTable, TSubclassOf<AEnemyBase> InDefaultEnemyClass, int32 InMaxEnemyCount)
+{
+	WaveTable = InWaveTable;
+	DefaultEnemyClass = InDefaultEnemyClass;
+	MaxEnemyCount = InMaxEnemyCount;
+	SortedRows.Reset();
+
+	if (!WaveTable)
+	{
+		UE_LOG(LogSevenDaysToAlive, Warning, TEXT("[SDTAWaveDirector] 未设置波次数据表，使用默认节奏（每天 %d 个敌人）"), DefaultEnemiesPerDay);
+		return;
+	}
+
+	if (!WaveTable->GetRowStruct() || !WaveTable->GetRowStruct()->IsChildOf(FSDTAWaveTableRow::StaticStruct()))
+	{
+		UE_LOG(LogSevenDaysToAlive, Error, TEXT("[SDTAWaveDirector] 波次数据表 %s 的行类型不是FSDTAWaveTableRow"), *WaveTable->GetName());
+		WaveTable = nullptr;
+		return;
+	}
+
+	TArray<FSDTAWaveTableRow*> Rows;
+	WaveTable->GetAllRows<FSDTAWaveTableRow>(TEXT("USDTAWaveDirector::Initialize"), Rows);
+	SortedRows.Append(Rows);
+	SortedRows.Sort([](const FSDTAWaveTableRow& A, const FSDTAWaveTableRow& B) { return A.Day < B.Day; });
+
+	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAWaveDirector] 加载波次数据表 %s，共 %d 行"), *WaveTable->GetName(), SortedRows.Num());
+}
+
+/**
+ * 开始一个夜晚
+ *
+ * 功能：选定当晚的数据行，计算敌人总数并缓存敌人组成的累积权重
+ *
+ * @param Day 当前天数
+ * @param InNightDuration 夜晚持续时间（秒）
+ * @param PlayerCount 当前玩家数量
+ */
+void USDTAWaveDirector::BeginNight(int32 Day, float InNightDuration, int32 PlayerCount)
+{
+	ActiveRow = GetRowForDay(Day);
+
+	CumulativeWeights.Reset(ActiveRow.EnemyMix.Num());
+	float TotalWeight = 0.0f;
+	for (const FSDTAWaveEnemyEntry& Entry : ActiveRow.EnemyMix)
+	{
+		TotalWeight += FMath::Max(0.0f, Entry.Weight);
+		CumulativeWeights.Add(TotalWeight);
+	}
+
+	bNightActive = true;
+	NightDuration = InNightDuration;
+	NightElapsed = 0.0f;
+	TimeSinceLastEmit = 0.0f;
+	TargetThisNight = GetTargetCount(ActiveRow, PlayerCount);
+	SpawnedThisNight = 0;
+
+	UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAWaveDirector] 第 %d 夜开始：计划生成 %d 个敌人（玩家 %d，存活上限 %d）"),
+	       Day, TargetThisNight, PlayerCount, FMath::Min(GetMaxAlive(ActiveRow, PlayerCount), MaxEnemyCount));
+}
+
+/**
+ * 结束当前夜晚
+ */
+void USDTAWaveDirector::EndNight()
+{
+	if (bNightActive)
+	{
+		UE_LOG(LogSevenDaysToAlive, Log, TEXT("[SDTAWaveDirector] 夜晚结束：已生成 %d / %d 个敌人"), SpawnedThisNight, TargetThisNight);
+	}
+
+	bNightActive = false;
+}
+
+/**
+ * 推进夜晚进度并计算当前应生成的敌人数量
+ *
+ * 功能：按生成曲线计算截至此刻欠下的敌人数量，并受存活上限限制
+ * 设计要点：
+ * 1. 每帧只做一次曲线求值和几次整数运算
+ * 2. 欠下的数量不足MinEmitBatch且距上次生成不足MaxEmitInterval时暂不生成，把小批量合并
+ *
+ * @param DeltaTime 帧间隔
+ * @param AliveCount 当前存活（含等待生成）的敌人数量
+ * @param PlayerCount 当前玩家数量
+ * @return 本帧应生成的敌人数量
+ */
+int32 USDTAWaveDirector::Advance(float DeltaTime, int32 AliveCount, int32 PlayerCount)
+{
+	if (!bNightActive)
+	{
+		return 0;
+	}
+
+	NightElapsed += DeltaTime;
+	TimeSinceLastEmit += DeltaTime;
+
+	const int32 MaxAlive = FMath::Min(GetMaxAlive(ActiveRow, PlayerCount), MaxEnemyCount);
+	const int32 Due = FMath::Min(GetScheduledCount() - SpawnedThisNight, MaxAlive - AliveCount);
+	if (Due <= 0)
+	{
+		return 0;
+	}
+
+	if (Due < MinEmitBatch && TimeSinceLastEmit < MaxEmitInterval && NightElapsed < NightDuration)
+	{
+		return 0;
+	}
+
+	return Due;
+}
+
+/**
+ * 记录已生成（入队）的敌人数量
+ *
+ * @param Count 敌人数量
+ */
+void USDTAWaveDirector::NotifySpawned(int32 Count)
+{
+	SpawnedThisNight += Count;
+	TimeSinceLastEmit = 0.0f;
+}
+
+/**
+ * 按当前夜晚的敌人组成随机选择一个敌人类型
+ *
+ * @return 敌人类型，组成项未指定类型时返回默认敌人类型
+ */
+TSubclassOf<AEnemyBase> USDTAWaveDirector::PickEnemyClass()
+{
+	if (CumulativeWeights.Num() == 0 || CumulativeWeights.Last() <= 0.0f)
+	{
+		return DefaultEnemyClass;
+	}
+
+	const float Roll = FMath::FRandRange(0.0f, CumulativeWeights.Last());
+	const int32 Index = FMath::Min(Algo::UpperBound(CumulativeWeights, Roll), CumulativeWeights.Num() - 1);
+	const TSubclassOf<AEnemyBase> EnemyClass = ActiveRow.EnemyMix[Index].EnemyClass;
+	return EnemyClass ? EnemyClass : DefaultEnemyClass;
+}
+
+/**
+ * 计算指定夜晚每种敌人的预计同时存活峰值
+ *
+ * 功能：峰值取敌人总数与存活上限中的较小值，再按权重分配给各敌人类型（向上取整）
+ *
+ * @param Day 天数
+ * @param PlayerCount 玩家数量
+ * @param OutCounts 输出：敌人类型到预计峰值的映射
+ */
+void USDTAWaveDirector::GetExpectedPeakCounts(int32 Day, int32 PlayerCount, TMap<UClass*, int32>& OutCounts) const
+{
+	OutCounts.Reset();
+
+	const FSDTAWaveTableRow Row = GetRowForDay(Day);
+	const int32 Peak = FMath::Min3(GetTargetCount(Row, PlayerCount), GetMaxAlive(Row, PlayerCount), MaxEnemyCount);
+	if (Peak <= 0)
+	{
+		return;
+	}
+
+	float TotalWeight = 0.0f;
+	for (const FSDTAWaveEnemyEntry& Entry : Row.EnemyMix)
+	{
+		TotalWeight += FMath::Max(0.0f, Entry.Weight);
+	}
+
+	if (TotalWeight <= 0.0f)
+	{
+		if (DefaultEnemyClass)
+		{
+			OutCounts.Add(DefaultEnemyClass, Peak);
+		}
+		return;
+	}
+
+	for (const FSDTAWaveEnemyEntry& Entry : Row.EnemyMix)
+	{
+		UClass* EnemyClass = Entry.EnemyClass ? Entry.EnemyClass.Get() : DefaultEnemyClass.Get();
+		if (EnemyClass && Entry.Weight > 0.0f)
+		{
+			OutCounts.FindOrAdd(EnemyClass) += FMath::CeilToInt(Peak * Entry.Weight / TotalWeight);
+		}
+	}
+}
+
+/**
+ * 指定天数生效的数据行
+ *
+ * 功能：返回Day不大于指定天数的最后一行；所有行的Day都更大时返回第一行；无数据表时返回默认行
+ *
+ * @param Day 天数
+ * @return 数据行拷贝
+ */
+FSDTAWaveTableRow USDTAWaveDirector::GetRowForDay(int32 Day) const
+{
+	if (SortedRows.Num() == 0)
+	{
+		FSDTAWaveTableRow Row;
+		Row.Day = Day;
+		Row.EnemiesPerNight = DefaultEnemiesPerDay * FMath::Max(1, Day);
+		Row.EnemyMix.AddDefaulted_GetRef().EnemyClass = DefaultEnemyClass;
+		return Row;
+	}
+
+	const FSDTAWaveTableRow* Selected = SortedRows[0];
+	for (const FSDTAWaveTableRow* Row : SortedRows)
+	{
+		if (Row->Day > Day)
+		{
+			break;
+		}
+		Selected = Row;
+	}
+
+	return *Selected;
+}
+
+/**
+ * 按玩家数量计算整晚敌人总数
+ */
+int32 USDTAWaveDirector::GetTargetCount(const FSDTAWaveTableRow& Row, int32 PlayerCount) const
+{
+	const int32 ExtraPlayers = FMath::Max(0, PlayerCount - 1);
+	return FMath::RoundToInt(Row.EnemiesPerNight * (1.0f + Row.ExtraEnemiesPerPlayer * ExtraPlayers));
+}
+
+/**
+ * 按玩家数量计算同时存活上限
+ */
+int32 USDTAWaveDirector::GetMaxAlive(const FSDTAWaveTableRow& Row, int32 PlayerCount) const
+{
+	if (Row.MaxAliveByPlayerCount.Num() == 0)
+	{
+		return MaxEnemyCount;
+	}
+
+	const int32 Index = FMath::Clamp(PlayerCount - 1, 0, Row.MaxAliveByPlayerCount.Num() - 1);
+	return Row.MaxAliveByPlayerCount[Index];
+}
+
+/**
+ * 在当前夜晚进度下，截至此刻应生成的敌人数量
+ *
+ * @return 生成曲线值 × 本夜敌人总数（曲线未配置时按进度线性计算）
+ */
+int32 USDTAWaveDirector::GetScheduledCount() const
+{
+	const float Progress = GetNightProgress();
+	const FRichCurve* Curve = ActiveRow.SpawnCurve.GetRichCurveConst();
+	const float Fraction = (Curve && Curve->GetNumKeys() > 0) ? FMath::Clamp(Curve->Eval(Progress), 0.0f, 1.0f) : Progress;
+
+	return FMath::FloorToInt(Fraction * TargetThisNight);
+}
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Variant_SDTA/Core/Game/Spawn/SDTAWaveTypes.h"
+#include "SDTAWaveDirector.generated.h"
+
+/**
+ * 波次导演
+ *
+ * 核心功能：
+ * 1. 从波次数据表读取每晚的敌人组成、生成曲线和按玩家数量的存活上限
+ * 2. 每帧按夜晚进度增量计算当前应生成的敌人数量，替代固定间隔的整波生成
+ * 3. 按权重为每个敌人选择类型，并为白天的对象池预热提供每种敌人的预计峰值
+ *
+ * 设计要点：
+ * - 夜晚开始时一次性拷贝数据行并缓存累积权重，每帧只做一次曲线求值
+ * - 积累到MinEmitBatch个敌人或距上次生成超过MaxEmitInterval时才交给GameMode，减少生成点规划次数
+ * - 未配置数据表时使用默认行（GameMode的EnemyClass，敌人总数随天数线性增长）
+ *
+ * 使用说明：
+ * - 由GameMode创建并推送配置，随后调用Initialize
+ * - 夜晚开始调用BeginNight，每帧调用Advance获取应生成数量，生成后调用NotifySpawned，白天开始调用EndNight
+ */
+UCLASS(BlueprintType)
+class SEVENDAYSTOALIVE_API USDTAWaveDirector : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	USDTAWaveDirector();
+
+	/**
+	 * 初始化波次导演
+	 *
+	 * @param InWaveTable 波次数据表（行类型为FSDTAWaveTableRow），可为空
+	 * @param InDefaultEnemyClass 默认敌人类型
+	 * @param InMaxEnemyCount 全局同时存活敌人上限
+	 */
+	void Initialize(UDataTable* InWaveTable, TSubclassOf<class AEnemyBase> InDefaultEnemyClass, int32 InMaxEnemyCount);
+
+	/**
+	 * 开始一个夜晚
+	 *
+	 * @param Day 当前天数
+	 * @param InNightDuration 夜晚持续时间（秒）
+	 * @param PlayerCount 当前玩家数量
+	 */
+	void BeginNight(int32 Day, float InNightDuration, int32 PlayerCount);
+
+	/** 结束当前夜晚，停止生成 */
+	void EndNight();
+
+	/**
+	 * 推进夜晚进度并计算当前应生成的敌人数量
+	 *
+	 * @param DeltaTime 帧间隔
+	 * @param AliveCount 当前存活（含等待生成）的敌人数量
+	 * @param PlayerCount 当前玩家数量
+	 * @return 本帧应生成的敌人数量，未到批量阈值时返回0
+	 */
+	int32 Advance(float DeltaTime, int32 AliveCount, int32 PlayerCount);
+
+	/** 记录已生成（入队）的敌人数量 */
+	void NotifySpawned(int32 Count);
+
+	/** 按当前夜晚的敌人组成随机选择一个敌人类型 */
+	TSubclassOf<class AEnemyBase> PickEnemyClass();
+
+	/**
+	 * 计算指定夜晚每种敌人的预计同时存活峰值（用于对象池预热）
+	 *
+	 * @param Day 天数
+	 * @param PlayerCount 玩家数量
+	 * @param OutCounts 输出：敌人类型到预计峰值的映射
+	 */
+	void GetExpectedPeakCounts(int32 Day, int32 PlayerCount, TMap<UClass*, int32>& OutCounts) const;
+
+	/** 当前是否处于夜晚生成阶段 */
+	UFUNCTION(BlueprintPure, Category = "Wave Director")
+	bool IsNightActive() const { return bNightActive; }
+
+	/** 当前夜晚进度（0~1） */
+	UFUNCTION(BlueprintPure, Category = "Wave Director")
+	float GetNightProgress() const { return NightDuration > 0.0f ? FMath::Clamp(NightElapsed / NightDuration, 0.0f, 1.0f) : 1.0f; }
+
+	/** 本夜已生成的敌人数量 */
+	UFUNCTION(BlueprintPure, Category = "Wave Director")
+	int32 GetSpawnedThisNight() const { return SpawnedThisNight; }
+
+	/** 本夜计划生成的敌人总数 */
+	UFUNCTION(BlueprintPure, Category = "Wave Director")
+	int32 GetTargetThisNight() const { return TargetThisNight; }
+
+public:
+	/** 积累到多少个待生成敌人时交给GameMode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Director", meta = (ClampMin = 1))
+	int32 MinEmitBatch;
+
+	/** 距上次生成超过该时间时，即使未达到MinEmitBatch也交给GameMode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Director", meta = (ClampMin = 0, Units = "s"))
+	float MaxEmitInterval;
+
+	/** 未配置数据表时，默认行每天增加的敌人数量 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Director", meta = (ClampMin = 0))
+	int32 DefaultEnemiesPerDay;
+
+protected:
+	/** 指定天数生效的数据行（拷贝），无数据表时返回默认行 */
+	FSDTAWaveTableRow GetRowForDay(int32 Day) const;
+
+	/** 按玩家数量计算整晚敌人总数 */
+	int32 GetTargetCount(const FSDTAWaveTableRow& Row, int32 PlayerCount) const;
+
+	/** 按玩家数量计算同时存活上限 */
+	int32 GetMaxAlive(const FSDTAWaveTableRow& Row, int32 PlayerCount) const;
+
+	/** 在当前夜晚进度下，截至此刻应生成的敌人数量 */
+	int32 GetScheduledCount() const;
+
+protected:
+	/** 波次数据表 */
+	UPROPERTY()
+	UDataTable* WaveTable;
+
+	/** 默认敌人类型 */
+	UPROPERTY()
+	TSubclassOf<class AEnemyBase> DefaultEnemyClass;
+
+	/** 全局同时存活敌人上限 */
+	int32 MaxEnemyCount;
+
+	/** 按Day升序排列的数据行（指向数据表内存） */
+	TArray<const FSDTAWaveTableRow*> SortedRows;
+
+	/** 当前夜晚使用的数据行 */
+	UPROPERTY()
+	FSDTAWaveTableRow ActiveRow;
+
+	/** 当前夜晚敌人组成的累积权重（与ActiveRow.EnemyMix一一对应） */
+	TArray<float> CumulativeWeights;
+
+	bool bNightActive;
+	float NightDuration;
+	float NightElapsed;
+	float TimeSinceLastEmit;
+	int32 TargetThisNight;
+	int32 SpawnedThisNight;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Curves/CurveFloat.h"
+#include "SDTAWaveTypes.generated.h"
+
+/**
+ * 波次敌人组成项
+ */
+USTRUCT(BlueprintType)
+struct FSDTAWaveEnemyEntry
+{
+	GENERATED_BODY()
+
+	/** 敌人类型（为空时使用GameMode的EnemyClass） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data")
+	TSubclassOf<class AEnemyBase> EnemyClass;
+
+	/** 该类型在本夜敌人中的权重 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data", Meta = (ClampMin = 0))
+	float Weight = 1.0f;
+};
+
+/**
+ * 波次数据表行，描述一个夜晚的敌人节奏
+ *
+ * 从Day指定的天数开始生效，直到下一个Day更大的行为止
+ */
+USTRUCT(BlueprintType)
+struct FSDTAWaveTableRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	/** 从第几天开始使用该行 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data", Meta = (ClampMin = 1))
+	int32 Day = 1;
+
+	/** 敌人组成，按权重随机选择类型 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data")
+	TArray<FSDTAWaveEnemyEntry> EnemyMix;
+
+	/** 单人时整晚生成的敌人总数 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data", Meta = (ClampMin = 0))
+	int32 EnemiesPerNight = 15;
+
+	/** 每多一名玩家增加的敌人比例（0.5表示每多一人多生成50%） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data", Meta = (ClampMin = 0))
+	float ExtraEnemiesPerPlayer = 0.5f;
+
+	/**
+	 * 夜晚内的生成曲线
+	 * 横轴为夜晚进度（0~1），纵轴为截至该时刻应生成的敌人比例（0~1），未配置时线性生成
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data")
+	FRuntimeFloatCurve SpawnCurve;
+
+	/** 按玩家数量的同时存活敌人上限（下标0为1名玩家，超出时使用最后一项），为空时只受MaxEnemyCount限制 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave Data")
+	TArray<int32> MaxAliveByPlayerCount;
+};
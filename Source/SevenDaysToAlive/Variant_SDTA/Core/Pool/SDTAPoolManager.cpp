@@ -10,37 +10,79 @@
  * 4. 对象状态的重置和生命周期管理
  * 
  * 实现细节：
- * - 采用双数组设计：PooledObjects（池化对象）和ActiveObjects（活跃对象）
- * - 使用UClass作为键的映射表，支持多类型对象管理
+ * - 采用槽位数组+空闲链表设计，配合带代数的句柄实现O(1)获取和回收
+ * - 按对象指针回收时读取ISDTAPoolable保存的句柄直接定位槽位，不使用对象到句柄的哈希表
+ * - 槽位中的对象通过AddReferencedObjects报告给GC；借出前、回收时和周期维护中校验对象是否仍有效
+ * - 使用UClass作为键的映射表定位对象池，支持多类型对象管理
  * - 自动处理Actor类型对象的生成和隐藏
- * - 支持网络环境下的安全操作
+ * - 支持网络环境下的安全操作，停放的Actor进入网络休眠，借出时唤醒
  * 
  * 设计要点：
- * - 服务器端权威：仅在服务器上启用对象池功能
+ * - 服务器端权威：复制的类型只在拥有权威的一端（单机/服务器）池化，客户端只池化不复制的表现类对象
  * - 延迟初始化：仅在需要时创建对象
- * - 自动重置：回收对象时自动重置状态
+ * - 自动重置：回收对象时自动重置状态，具体类型通过ISDTAPoolable接口自行重置
  * - 安全检查：完善的空指针和有效性检查
  * 
  * 关键方法：
- * - Initialize：初始化对象池管理器，设置世界上下文
+ * - Get：获取世界中的对象池子系统
+ * - Initialize/Deinitialize：随世界创建和销毁，销毁时确定性地释放所有对象池
  * - GetObject：从池中获取对象，或在需要时创建新对象
  * - ReturnObject：将对象回收回池中，重置状态
+ * - ReleaseObject：通过句柄回收对象，不涉及哈希查找
+ * - AcquireBatch/ReleaseBatch：批量获取和回收，分遍处理并统一更新渲染和碰撞状态
+ * - PrewarmPoolAsync：按每帧时间预算分帧预热对象池
+ * - MaintainPools：按需求统计周期性收缩空闲对象或提前扩容
+ * - DumpPoolStats：输出各对象池的遥测统计（控制台命令 sdta.Pool.Dump）
  */
 
 #include "SDTAPoolManager.h"
 #include "Engine/World.h"
 #include "UObject/UObjectGlobals.h"
 #include "Templates/Casts.h"
-#include "GameFramework/ProjectileMovementComponent.h"
-#include "Components/PrimitiveComponent.h"
 #include "GameFramework/Actor.h"
+#include "TimerManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolableInterface.h"
 
-// 包含敌人基类头文件，用于敌人对象的特殊处理
-#include "Variant_SDTA/Enemies/AI/EnemyBase.h"
+/** 定义自定义日志类别：对象池 */
+DEFINE_LOG_CATEGORY(LogSDTAPool);
 
-// 包含工作台头文件，用于工作台对象的特殊处理
-#include "Variant_SDTA/Upgrade/WorkStation.h"
+// 对象池性能统计（控制台输入 stat SDTAPool 查看）
+DECLARE_STATS_GROUP(TEXT("SDTA Pool"), STATGROUP_SDTAPool, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Acquire"), STAT_SDTAPool_Acquire, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Release"), STAT_SDTAPool_Release, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Acquire Batch"), STAT_SDTAPool_AcquireBatch, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Release Batch"), STAT_SDTAPool_ReleaseBatch, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Reset Object"), STAT_SDTAPool_Reset, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Create Object"), STAT_SDTAPool_Create, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Prewarm Tick"), STAT_SDTAPool_Prewarm, STATGROUP_SDTAPool);
+DECLARE_CYCLE_STAT(TEXT("Maintain"), STAT_SDTAPool_Maintain, STATGROUP_SDTAPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Acquisitions"), STAT_SDTAPool_Acquisitions, STATGROUP_SDTAPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Misses"), STAT_SDTAPool_Misses, STATGROUP_SDTAPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Returns"), STAT_SDTAPool_Returns, STATGROUP_SDTAPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rejected Returns"), STAT_SDTAPool_RejectedReturns, STATGROUP_SDTAPool);
 
+/**
+ * 控制台命令：sdta.Pool.Dump
+ * 
+ * 功能：输出当前世界中所有对象池管理器的统计数据
+ */
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GSDTAPoolDumpCommand(
+	TEXT("sdta.Pool.Dump"),
+	TEXT("输出当前世界中所有对象池的统计数据（获取、未命中、回收、拒绝回收、活跃峰值、池中平均停留时间、平均重置耗时）"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		if (USDTAPoolManager* PoolManager = USDTAPoolManager::Get(InWorld))
+		{
+			PoolManager->DumpPoolStats(Ar);
+		}
+		else
+		{
+			Ar.Logf(TEXT("[SDTAPool] 当前世界没有对象池管理器"));
+		}
+	}));
 
 /**
  * USDTAPoolManager构造函数
@@ -48,319 +90,1319 @@
  * 功能：初始化对象池管理器的成员变量
  * 设计要点：采用初始化列表设置World为nullptr，确保安全初始状态
  */
-USDTAPoolManager::USDTAPoolManager()
-	: World(nullptr)
+USDTAPoolManager::USDTAPoolManager()
+	: PrewarmBudgetMs(2.0f)
+	, bEnableAdaptiveSizing(true)
+	, MaintenanceInterval(1.0f)
+	, TrimQuietPeriod(30.0f)
+	, MinIdleCount(4)
+	, IdleKeepRatio(0.25f)
+	, TrimBatchSize(8)
+	, GrowLookaheadSeconds(2.0f)
+	, AcquireRateSmoothing(0.3f)
+	, World(nullptr)
+	, bPrewarmTickScheduled(false)
+{
+}
+
+/**
+ * 获取世界中的对象池管理器
+ * 
+ * 功能：从世界上下文对象所在的世界获取对象池子系统
+ * 设计要点：子系统按类直接索引，不再经过GameMode转换，客户端也可以获取
+ * 
+ * @param WorldContextObject 世界上下文对象
+ * @return 对象池管理器，不支持的世界返回nullptr
+ */
+USDTAPoolManager* USDTAPoolManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* ContextWorld = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return ContextWorld ? ContextWorld->GetSubsystem<USDTAPoolManager>() : nullptr;
+}
+
+/**
+ * 子系统初始化
+ * 
+ * 功能：缓存世界上下文
+ * 设计要点：此时网络驱动可能尚未创建，网络模式相关的判断推迟到创建对象池时进行
+ * 
+ * @param Collection 子系统集合
+ */
+void USDTAPoolManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	World = GetWorld();
+}
+
+/**
+ * 世界开始游戏
+ * 
+ * 功能：启动周期性维护（需求采样、空闲收缩、提前扩容）
+ * 
+ * @param InWorld 所在世界
+ */
+void USDTAPoolManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (World && bEnableAdaptiveSizing)
+	{
+		World->GetTimerManager().SetTimer(MaintenanceTimer, this, &USDTAPoolManager::MaintainPools, MaintenanceInterval, true);
+	}
+}
+
+/**
+ * 子系统反初始化
+ * 
+ * 功能：随世界销毁确定性地释放对象池
+ * 设计要点：池中Actor由世界一并销毁，这里只停止定时器并释放所有引用，
+ *          避免在世界销毁过程中逐个销毁Actor
+ */
+void USDTAPoolManager::Deinitialize()
+{
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(MaintenanceTimer);
+	}
+
+	PrewarmQueue.Empty();
+	Pools.Empty();
+	PoolIndexByClass.Empty();
+	World = nullptr;
+
+	Super::Deinitialize();
+}
+
+/**
+ * 向GC报告槽位中的对象
+ * 
+ * 功能：槽位持有对象的强引用，非Actor对象不会在池中被GC回收
+ * 设计要点：在对象池外被销毁的Actor会被GC清空引用，借出和维护时按空槽位处理
+ * 
+ * @param InThis 对象池管理器
+ * @param Collector 引用收集器
+ */
+void USDTAPoolManager::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	USDTAPoolManager* This = CastChecked<USDTAPoolManager>(InThis);
+	for (FPoolConfig& PoolConfig : This->Pools)
+	{
+		for (FPoolSlot& Slot : PoolConfig.Slots)
+		{
+			Collector.AddReferencedObject(Slot.Object, This);
+		}
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+/**
+ * 是否支持指定类型的世界
+ * 
+ * 功能：只在游戏世界和PIE世界中创建对象池，编辑器和预览世界不需要
+ * 
+ * @param WorldType 世界类型
+ * @return 支持返回true
+ */
+bool USDTAPoolManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * 是否允许池化指定类型
+ * 
+ * 功能：服务器和单机允许池化任何类型；客户端只允许不复制的类型
+ * 设计要点：复制的Actor由服务器生成并同步，客户端本地池化会产生无法同步的副本；
+ *          曳光、弹孔、弹壳等纯表现对象不复制，可以在客户端本地池化
+ * 
+ * @param Class 要池化的类型
+ * @return 允许返回true
+ */
+bool USDTAPoolManager::CanPoolClass(UClass* Class) const
+{
+	if (!World || World->GetNetMode() != NM_Client)
+	{
+		return true;
+	}
+
+	const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+	return !ActorCDO || !ActorCDO->GetIsReplicated();
+}
+
+/**
+ * 为特定类初始化对象池
+ * 
+ * 功能：创建并配置特定类型对象的对象池
+ * 设计要点：支持预创建对象、设置最大容量限制，避免重复初始化
+ * 
+ * @param ObjectClass 要池化的对象类型
+ * @param InitialSize 对象池初始大小，预创建的对象数量
+ * @param MaxSize 对象池最大大小，-1表示无限制
+ */
+void USDTAPoolManager::InitPoolForClass(TSubclassOf<UObject> ObjectClass, int32 InitialSize, int32 MaxSize)
+{
+	if (!World || !ObjectClass || InitialSize < 0)
+	{
+		return;
+	}
+
+	UClass* Class = ObjectClass.Get();
+
+	// 检查是否已经存在该类型的对象池
+	if (PoolIndexByClass.Contains(Class))
+	{
+		return;
+	}
+
+	if (!CanPoolClass(Class))
+	{
+		UE_LOG(LogSDTAPool, Verbose, TEXT("[SDTAPool] 客户端不池化复制的类型: %s"), *Class->GetName());
+		return;
+	}
+
+	// 创建新的对象池配置（池索引只追加不复用）
+	const int32 PoolIndex = Pools.Emplace(ObjectClass, MaxSize);
+	PoolIndexByClass.Add(Class, PoolIndex);
+	Pools[PoolIndex].Slots.Reserve(InitialSize);
+	Pools[PoolIndex].ReservedSize = InitialSize;
+	Pools[PoolIndex].bPoolable = Class->ImplementsInterface(USDTAPoolable::StaticClass());
+
+	// 预创建初始数量的对象
+	for (int32 i = 0; i < InitialSize; ++i)
+	{
+		UObject* NewObject = CreateNewObject(ObjectClass);
+		if (NewObject)
+		{
+			AddSlot(PoolIndex, NewObject);
+		}
+	}
+}
+
+/**
+ * 分帧异步预热对象池
+ * 
+ * 功能：登记预热请求，从下一帧开始在时间预算内逐步创建对象
+ * 设计要点：
+ * 1. 对象池不存在时先创建空池，随后的GetObject可以立即使用已预热的部分
+ * 2. 同一对象池只保留一个请求，重复调用时取较大的目标数量
+ * 3. 目标数量受MaxSize限制
+ * 
+ * @param ObjectClass 要池化的对象类型
+ * @param TargetSize 预热完成后池中对象总数
+ * @param MaxSize 对象池最大大小，-1表示无限制
+ * @param BudgetMs 每帧时间预算（毫秒）
+ */
+void USDTAPoolManager::PrewarmPoolAsync(TSubclassOf<UObject> ObjectClass, int32 TargetSize, int32 MaxSize, float BudgetMs)
+{
+	if (!World || !ObjectClass || TargetSize <= 0)
+	{
+		return;
+	}
+
+	InitPoolForClass(ObjectClass, 0, MaxSize);
+	const int32 PoolIndex = FindOrCreatePool(ObjectClass);
+	if (PoolIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// 显式预热的目标数量作为收缩下限，避免白天预热的对象在空闲期被收缩掉；
+	// 较小的后续预热请求不降低已有的下限
+	Pools[PoolIndex].ReservedSize = FMath::Max(Pools[PoolIndex].ReservedSize, TargetSize);
+
+	QueuePrewarm(PoolIndex, TargetSize, BudgetMs);
+}
+
+/**
+ * 登记预热请求
+ * 
+ * 功能：将预热请求加入队列并安排处理，供显式预热和自适应扩容共用
+ * 
+ * @param PoolIndex 对象池索引
+ * @param TargetSize 预热完成后池中对象总数
+ * @param BudgetMs 每帧时间预算（毫秒），<=0时使用PrewarmBudgetMs
+ */
+void USDTAPoolManager::QueuePrewarm(int32 PoolIndex, int32 TargetSize, float BudgetMs)
+{
+	const FPoolConfig& PoolConfig = Pools[PoolIndex];
+	if (PoolConfig.MaxSize != -1)
+	{
+		TargetSize = FMath::Min(TargetSize, PoolConfig.MaxSize);
+	}
+
+	if (BudgetMs <= 0.0f)
+	{
+		BudgetMs = PrewarmBudgetMs;
+	}
+
+	// 合并同一对象池的请求
+	FPrewarmRequest* ExistingRequest = PrewarmQueue.FindByPredicate([PoolIndex](const FPrewarmRequest& Request)
+	{
+		return Request.PoolIndex == PoolIndex;
+	});
+
+	if (ExistingRequest)
+	{
+		ExistingRequest->TargetSize = FMath::Max(ExistingRequest->TargetSize, TargetSize);
+		ExistingRequest->BudgetMs = BudgetMs;
+	}
+	else
+	{
+		PrewarmQueue.Emplace(PoolIndex, TargetSize, BudgetMs);
+	}
+
+	SchedulePrewarmTick();
+}
+
+/**
+ * 安排下一帧处理预热队列
+ */
+void USDTAPoolManager::SchedulePrewarmTick()
+{
+	if (!World || bPrewarmTickScheduled || PrewarmQueue.Num() == 0)
+	{
+		return;
+	}
+
+	bPrewarmTickScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &USDTAPoolManager::ProcessPrewarmQueue));
+}
+
+/**
+ * 处理异步预热队列
+ * 
+ * 功能：在本帧时间预算内按队列顺序创建对象，并广播进度和完成事件
+ * 设计要点：
+ * 1. 每帧至少创建一个对象，保证预算过小时预热仍能推进
+ * 2. 对象池已被清除或已达到目标的请求直接完成
+ * 3. 事件回调中可能再次登记请求，因此先出队再广播
+ */
+void USDTAPoolManager::ProcessPrewarmQueue()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_Prewarm);
+
+	bPrewarmTickScheduled = false;
+
+	if (!World || PrewarmQueue.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = PrewarmQueue[0].BudgetMs * 0.001;
+	bool bCreatedAny = false;
+
+	while (PrewarmQueue.Num() > 0)
+	{
+		const FPrewarmRequest Request = PrewarmQueue[0];
+		FPoolConfig& PoolConfig = Pools[Request.PoolIndex];
+		UClass* ObjectClass = PoolConfig.ObjectClass.Get();
+
+		// 对象池已被清除或已达到目标数量
+		if (!ObjectClass || PoolConfig.Num() >= Request.TargetSize)
+		{
+			PrewarmQueue.RemoveAt(0);
+			if (ObjectClass)
+			{
+				OnPoolPrewarmCompleted.Broadcast(ObjectClass, PoolConfig.Num());
+			}
+			continue;
+		}
+
+		// 预算用尽（至少创建一个对象后才检查）
+		if (bCreatedAny && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+
+		UObject* NewObject = CreateNewObject(ObjectClass);
+		if (!NewObject)
+		{
+			// 创建失败时放弃该请求，避免每帧重复失败
+			PrewarmQueue.RemoveAt(0);
+			OnPoolPrewarmCompleted.Broadcast(ObjectClass, Pools[Request.PoolIndex].Num());
+			continue;
+		}
+
+		AddSlot(Request.PoolIndex, NewObject);
+		bCreatedAny = true;
+
+		// 每个请求在预算用尽或完成时广播一次进度
+		const int32 CreatedCount = Pools[Request.PoolIndex].Num();
+		if (CreatedCount >= Request.TargetSize || FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			OnPoolPrewarmProgress.Broadcast(ObjectClass, CreatedCount, Request.TargetSize);
+		}
+	}
+
+	SchedulePrewarmTick();
+}
+
+/**
+ * 查找或创建指定类的对象池
+ * 
+ * 功能：按类查找对象池索引，不存在时创建默认配置的对象池
+ * 
+ * @param ObjectClass 对象类型
+ * @return 对象池索引，失败返回INDEX_NONE
+ */
+int32 USDTAPoolManager::FindOrCreatePool(TSubclassOf<UObject> ObjectClass)
+{
+	UClass* Class = ObjectClass.Get();
+
+	if (const int32* PoolIndex = PoolIndexByClass.Find(Class))
+	{
+		return *PoolIndex;
+	}
+
+	// 如果不存在，创建一个默认配置的对象池
+	InitPoolForClass(ObjectClass, 0, -1);
+	const int32* PoolIndex = PoolIndexByClass.Find(Class);
+	return PoolIndex ? *PoolIndex : INDEX_NONE;
+}
+
+/**
+ * 为新对象分配槽位
+ * 
+ * 功能：将新创建的对象放入对象池的槽位，并压入空闲链表
+ * 设计要点：
+ * 1. 优先复用被收缩清空的槽位，槽位数组只在对象总数超过历史峰值时增长
+ * 2. 实现ISDTAPoolable的对象在此处记录槽位句柄，之后按对象指针回收时直接定位槽位
+ * 
+ * @param PoolIndex 对象池索引
+ * @param Object 新创建的对象
+ * @return 分配的槽位索引
+ */
+int32 USDTAPoolManager::AddSlot(int32 PoolIndex, UObject* Object)
+{
+	FPoolConfig& PoolConfig = Pools[PoolIndex];
+
+	int32 SlotIndex = PoolConfig.EmptyHead;
+	if (SlotIndex != INDEX_NONE)
+	{
+		PoolConfig.EmptyHead = PoolConfig.Slots[SlotIndex].NextFree;
+	}
+	else
+	{
+		SlotIndex = PoolConfig.Slots.AddDefaulted();
+	}
+
+	FPoolSlot& Slot = PoolConfig.Slots[SlotIndex];
+	Slot.Object = Object;
+	Slot.Poolable = PoolConfig.bPoolable ? Cast<ISDTAPoolable>(Object) : nullptr;
+	Slot.ReleaseTime = World ? World->GetTimeSeconds() : 0.0;
+	Slot.NextFree = PoolConfig.FreeHead;
+	PoolConfig.FreeHead = SlotIndex;
+	PoolConfig.PooledCount++;
+
+	if (Slot.Poolable)
+	{
+		Slot.Poolable->PoolHandle = FSDTAPoolHandle(PoolIndex, SlotIndex, Slot.Generation);
+	}
+
+	return SlotIndex;
+}
+
+/**
+ * 从对象池中获取对象
+ * 
+ * 功能：优先从池中获取对象，如池为空且未达最大容量则创建新对象
+ * 设计要点：自动管理对象状态、处理Actor类型特殊逻辑
+ * 
+ * @param ObjectClass 要获取的对象类型
+ * @return 返回获取或创建的对象指针，如失败则返回nullptr
+ */
+UObject* USDTAPoolManager::GetObject(TSubclassOf<UObject> ObjectClass)
+{
+	FSDTAPoolHandle Handle;
+	return GetObjectWithHandle(ObjectClass, Handle);
+}
+
+/**
+ * 从对象池中获取对象并返回句柄
+ * 
+ * 功能：按类定位对象池后借出对象
+ * 设计要点：每次调用只做一次类到池索引的查找，借出过程本身为O(1)
+ * 
+ * @param ObjectClass 要获取的对象类型
+ * @param OutHandle 输出参数：对象句柄
+ * @return 返回获取或创建的对象指针，如失败则返回nullptr
+ */
+UObject* USDTAPoolManager::GetObjectWithHandle(TSubclassOf<UObject> ObjectClass, FSDTAPoolHandle& OutHandle)
+{
+	OutHandle.Invalidate();
+
+	if (!ObjectClass || !World)
+	{
+		return nullptr;
+	}
+
+	// 检查是否存在该类型的对象池
+	const int32 PoolIndex = FindOrCreatePool(ObjectClass);
+	if (PoolIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return AcquireFromPool(PoolIndex, OutHandle);
+}
+
+/**
+ * 从指定对象池借出对象
+ * 
+ * 功能：从空闲链表头弹出槽位；链表为空且未达最大容量时创建新对象
+ * 设计要点：弹出空闲槽位和标记活跃均为O(1)，不涉及哈希或线性扫描
+ * 
+ * @param PoolIndex 对象池索引
+ * @param OutHandle 输出参数：对象句柄
+ * @return 借出的对象，失败返回nullptr
+ */
+UObject* USDTAPoolManager::AcquireFromPool(int32 PoolIndex, FSDTAPoolHandle& OutHandle)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_Acquire);
+
+	const int32 SlotIndex = PopFreeSlot(PoolIndex);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return FinishAcquire(PoolIndex, SlotIndex, OutHandle);
+}
+
+/**
+ * 弹出空闲槽位
+ * 
+ * 功能：从空闲链表头取出槽位并标记为活跃，同时记录需求和遥测统计
+ * 设计要点：
+ * 1. 链表头的对象已在对象池外被销毁时，丢弃该槽位后继续取下一个，不会借出失效对象
+ * 2. 链表为空且未达最大容量时创建新对象并计为一次未命中
+ * 
+ * @param PoolIndex 对象池索引
+ * @return 槽位索引，失败返回INDEX_NONE
+ */
+int32 USDTAPoolManager::PopFreeSlot(int32 PoolIndex)
+{
+	// 丢弃已在对象池外被销毁的空闲对象（关卡卸载、直接调用Destroy等）
+	while (Pools[PoolIndex].FreeHead != INDEX_NONE)
+	{
+		FPoolConfig& FreePool = Pools[PoolIndex];
+		const int32 HeadIndex = FreePool.FreeHead;
+		if (IsValid(FreePool.Slots[HeadIndex].Object))
+		{
+			break;
+		}
+
+		FreePool.FreeHead = FreePool.Slots[HeadIndex].NextFree;
+		RetireSlot(PoolIndex, HeadIndex);
+	}
+
+	// 如果池为空且未达到最大大小，则创建新对象
+	if (Pools[PoolIndex].FreeHead == INDEX_NONE)
+	{
+		const FPoolConfig& FullPool = Pools[PoolIndex];
+		if (FullPool.MaxSize != -1 && FullPool.ActiveCount >= FullPool.MaxSize)
+		{
+			return INDEX_NONE;
+		}
+
+		// 新对象的BeginPlay可能再创建其他对象池，因此创建后再重新取池引用
+		UObject* NewObject = CreateNewObject(FullPool.ObjectClass);
+		if (!NewObject)
+		{
+			return INDEX_NONE;
+		}
+
+		AddSlot(PoolIndex, NewObject);
+
+		// 未命中：空闲链表为空，本次获取触发了对象创建
+		Pools[PoolIndex].Stats.Misses++;
+		INC_DWORD_STAT(STAT_SDTAPool_Misses);
+	}
+
+	FPoolConfig& PoolConfig = Pools[PoolIndex];
+
+	// 从空闲链表头取出槽位
+	const int32 SlotIndex = PoolConfig.FreeHead;
+	FPoolSlot& Slot = PoolConfig.Slots[SlotIndex];
+	PoolConfig.FreeHead = Slot.NextFree;
+	Slot.NextFree = INDEX_NONE;
+
+	// 将对象标记为活跃
+	Slot.bActive = true;
+	PoolConfig.PooledCount--;
+	PoolConfig.ActiveCount++;
+
+	// 记录需求统计
+	const double Now = World->GetTimeSeconds();
+	PoolConfig.HighWaterMark = FMath::Max(PoolConfig.HighWaterMark, PoolConfig.ActiveCount);
+	PoolConfig.AcquiresSinceSample++;
+	PoolConfig.LastAcquireTime = Now;
+
+	FSDTAPoolStats& Stats = PoolConfig.Stats;
+	Stats.Acquisitions++;
+	Stats.PeakActive = FMath::Max(Stats.PeakActive, PoolConfig.ActiveCount);
+	Stats.TotalTimeInPool += Now - Slot.ReleaseTime;
+	INC_DWORD_STAT(STAT_SDTAPool_Acquisitions);
+
+	return SlotIndex;
+}
+
+/**
+ * 完成借出
+ * 
+ * 功能：为已弹出的槽位生成句柄并重置对象状态
+ * 
+ * @param PoolIndex 对象池索引
+ * @param SlotIndex 已弹出的槽位索引
+ * @param OutHandle 输出参数：对象句柄
+ * @return 槽位中的对象
+ */
+UObject* USDTAPoolManager::FinishAcquire(int32 PoolIndex, int32 SlotIndex, FSDTAPoolHandle& OutHandle)
+{
+	const FPoolSlot& Slot = Pools[PoolIndex].Slots[SlotIndex];
+	OutHandle = FSDTAPoolHandle(PoolIndex, SlotIndex, Slot.Generation);
+
+	// 重置对象状态（ResetObject可能触发蓝图逻辑，先取出对象指针）
+	UObject* Object = Slot.Object;
+	const uint64 ResetStartCycles = FPlatformTime::Cycles64();
+	ResetObject(Object, Slot.Poolable, OutHandle);
+	Pools[PoolIndex].Stats.TotalResetSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - ResetStartCycles);
+
+	return Object;
+}
+
+/**
+ * 将对象回收到对象池中
+ * 
+ * 功能：将活跃对象从世界中移除并重置状态，放回池中待复用
+ * 设计要点：通过ISDTAPoolable保存的句柄定位槽位，随后走与句柄回收相同的O(1)路径
+ * 
+ * @param Object 要回收的对象指针
+ * @return 回收成功返回true，失败返回false
+ */
+bool USDTAPoolManager::ReturnObject(UObject* Object)
+{
+	if (!World || !Object)
+	{
+		return false;
+	}
+
+	FSDTAPoolHandle Handle;
+	if (!FindCurrentHandle(Object, Handle))
+	{
+		// 非池化对象：若同类对象池存在，则计入该池的拒绝回收
+		const int32* ClassPoolIndex = PoolIndexByClass.Find(Object->GetClass());
+		RecordRejectedReturn(ClassPoolIndex ? *ClassPoolIndex : INDEX_NONE, Object);
+		return false;
+	}
+
+	return ReleaseObject(Handle);
+}
+
+/**
+ * 对象是否由对象池创建
+ * 
+ * @param Object 要检查的对象
+ * @return 对象占有对象池的槽位时返回true
+ */
+bool USDTAPoolManager::OwnsObject(const UObject* Object) const
+{
+	FSDTAPoolHandle Handle;
+	return FindCurrentHandle(Object, Handle);
+}
+
+/**
+ * 查找对象当前代数的句柄
+ * 
+ * 功能：读取对象通过ISDTAPoolable保存的句柄定位槽位，并按槽位当前代数生成句柄
+ * 设计要点：
+ * 1. 按对象指针回收时调用方不持有句柄，旧句柄的代数检查在这里不适用
+ * 2. 槽位中的对象必须就是该对象，槽位被收缩或对象池被清除后旧句柄不会误中其他对象
+ * 3. 未实现ISDTAPoolable的对象没有保存句柄，只能通过ReleaseObject回收
+ * 
+ * @param Object 要查找的对象
+ * @param OutHandle 输出参数：对象句柄
+ * @return 对象由对象池创建时返回true
+ */
+bool USDTAPoolManager::FindCurrentHandle(const UObject* Object, FSDTAPoolHandle& OutHandle) const
+{
+	const ISDTAPoolable* Poolable = Cast<ISDTAPoolable>(Object);
+	if (!Poolable)
+	{
+		return false;
+	}
+
+	const FSDTAPoolHandle& SavedHandle = Poolable->GetPoolHandle();
+	if (!SavedHandle.IsValid() || !Pools.IsValidIndex(SavedHandle.PoolIndex))
+	{
+		return false;
+	}
+
+	const FPoolConfig& PoolConfig = Pools[SavedHandle.PoolIndex];
+	if (!PoolConfig.Slots.IsValidIndex(SavedHandle.SlotIndex))
+	{
+		return false;
+	}
+
+	const FPoolSlot& Slot = PoolConfig.Slots[SavedHandle.SlotIndex];
+	if (Slot.Object != Object)
+	{
+		return false;
+	}
+
+	OutHandle = FSDTAPoolHandle(SavedHandle.PoolIndex, SavedHandle.SlotIndex, Slot.Generation);
+	return true;
+}
+
+/**
+ * 通过句柄将对象回收到对象池中
+ * 
+ * 功能：校验句柄代数后将槽位压回空闲链表，并隐藏Actor
+ * 设计要点：过期句柄或重复回收会被拒绝，代数递增使外部持有的旧句柄失效
+ * 
+ * @param Handle 获取对象时得到的句柄
+ * @return 回收成功返回true，失败返回false
+ */
+bool USDTAPoolManager::ReleaseObject(const FSDTAPoolHandle& Handle)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_Release);
+
+	if (!PushFreeSlot(Handle))
+	{
+		return false;
+	}
+
+	const FPoolSlot& Slot = Pools[Handle.PoolIndex].Slots[Handle.SlotIndex];
+	ParkObject(Slot.Object, Slot.Poolable);
+
+	return true;
+}
+
+/**
+ * 压回空闲槽位
+ * 
+ * 功能：校验句柄后将槽位压回空闲链表并记录统计，对象的停放由调用方完成
+ * 设计要点：对象已在对象池外被销毁时不放回空闲链表，槽位直接转入空槽位链表
+ * 
+ * @param Handle 获取对象时得到的句柄
+ * @return 句柄有效且对象处于活跃状态时返回true
+ */
+bool USDTAPoolManager::PushFreeSlot(const FSDTAPoolHandle& Handle)
+{
+	if (!World || !Handle.IsValid() || !Pools.IsValidIndex(Handle.PoolIndex))
+	{
+		return false;
+	}
+
+	FPoolConfig& PoolConfig = Pools[Handle.PoolIndex];
+	if (!PoolConfig.Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return false;
+	}
+
+	FPoolSlot& Slot = PoolConfig.Slots[Handle.SlotIndex];
+	if (!Slot.bActive || Slot.Generation != Handle.Generation)
+	{
+		// 重复回收或过期句柄
+		RecordRejectedReturn(Handle.PoolIndex, Slot.Object);
+		return false;
+	}
+
+	if (!IsValid(Slot.Object))
+	{
+		// 对象已被销毁，不能再借出
+		RecordRejectedReturn(Handle.PoolIndex, Slot.Object);
+		RetireSlot(Handle.PoolIndex, Handle.SlotIndex);
+		return false;
+	}
+
+	// 将槽位放回空闲链表
+	Slot.bActive = false;
+	Slot.Generation++;
+	Slot.ReleaseTime = World->GetTimeSeconds();
+	Slot.NextFree = PoolConfig.FreeHead;
+	PoolConfig.FreeHead = Handle.SlotIndex;
+	PoolConfig.ActiveCount--;
+	PoolConfig.PooledCount++;
+
+	PoolConfig.Stats.Returns++;
+	INC_DWORD_STAT(STAT_SDTAPool_Returns);
+
+	return true;
+}
+
+/**
+ * 批量获取对象
+ * 
+ * 功能：一次借出多个同类型对象并放置到各自的目标变换
+ * 设计要点：
+ * 1. 只做一次类到池索引的查找，预留槽位容量，避免逐个借出时的重复开销
+ * 2. 分三遍处理：先弹出槽位，再在隐藏且碰撞关闭的状态下放置（不触发重叠检测），
+ *    最后统一重置；对象只在最终位置显示一次，而不是先在原点显示再移动
+ * 
+ * @param ObjectClass 要获取的对象类型
+ * @param Count 获取数量
+ * @param Transforms 每个对象的目标变换
+ * @param OutObjects 输出参数：获取到的对象
+ * @return 实际获取数量
+ */
+int32 USDTAPoolManager::AcquireBatch(TSubclassOf<UObject> ObjectClass, int32 Count, const TArray<FTransform>& Transforms, TArray<UObject*>& OutObjects)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_AcquireBatch);
+
+	OutObjects.Reset();
+
+	if (!ObjectClass || !World || Count <= 0)
+	{
+		return 0;
+	}
+
+	const int32 PoolIndex = FindOrCreatePool(ObjectClass);
+	if (PoolIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	// 预计需要新建的对象数量，提前预留槽位和句柄映射容量
+	const int32 ExpectedMisses = FMath::Max(0, Count - Pools[PoolIndex].PooledCount);
+	if (ExpectedMisses > 0)
+	{
+		Pools[PoolIndex].Slots.Reserve(Pools[PoolIndex].Slots.Num() + ExpectedMisses);
+	}
+
+	// 第一遍：弹出槽位
+	TArray<int32, TInlineAllocator<64>> SlotIndices;
+	SlotIndices.Reserve(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const int32 SlotIndex = PopFreeSlot(PoolIndex);
+		if (SlotIndex == INDEX_NONE)
+		{
+			break;
+		}
+		SlotIndices.Add(SlotIndex);
+	}
+
+	// 第二遍：对象仍处于隐藏且碰撞关闭的状态，直接放置到目标变换
+	for (int32 i = 0; i < SlotIndices.Num() && Transforms.IsValidIndex(i); ++i)
+	{
+		if (AActor* Actor = Cast<AActor>(Pools[PoolIndex].Slots[SlotIndices[i]].Object))
+		{
+			Actor->SetActorTransform(Transforms[i], false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+
+	// 第三遍：统一重置（唤醒网络休眠、显示、开启碰撞）
+	OutObjects.Reserve(SlotIndices.Num());
+	for (const int32 SlotIndex : SlotIndices)
+	{
+		FSDTAPoolHandle Handle;
+		OutObjects.Add(FinishAcquire(PoolIndex, SlotIndex, Handle));
+	}
+
+	return OutObjects.Num();
+}
+
+/**
+ * 批量回收对象
+ * 
+ * 功能：一次回收多个对象，对象可以来自不同的对象池
+ * 设计要点：先完成所有槽位的回收计数，再统一停放对象；无法回收的对象交还调用方处理
+ * 
+ * @param Objects 要回收的对象
+ * @param OutRejected 输出参数：无法回收的对象
+ * @return 成功回收的数量
+ */
+int32 USDTAPoolManager::ReleaseBatch(const TArray<UObject*>& Objects, TArray<UObject*>& OutRejected)
+{
+	OutRejected.Reset();
+
+	if (!World)
+	{
+		OutRejected = Objects;
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_ReleaseBatch);
+
+	// 第一遍：压回空闲链表
+	TArray<FSDTAPoolHandle, TInlineAllocator<64>> Released;
+	Released.Reserve(Objects.Num());
+	for (UObject* Object : Objects)
+	{
+		if (!Object)
+		{
+			continue;
+		}
+
+		FSDTAPoolHandle Handle;
+		if (!FindCurrentHandle(Object, Handle))
+		{
+			const int32* ClassPoolIndex = PoolIndexByClass.Find(Object->GetClass());
+			RecordRejectedReturn(ClassPoolIndex ? *ClassPoolIndex : INDEX_NONE, Object);
+			OutRejected.Add(Object);
+			continue;
+		}
+
+		if (!PushFreeSlot(Handle))
+		{
+			OutRejected.Add(Object);
+			continue;
+		}
+
+		Released.Add(Handle);
+	}
+
+	// 第二遍：统一停放
+	for (const FSDTAPoolHandle& Handle : Released)
+	{
+		const FPoolSlot& Slot = Pools[Handle.PoolIndex].Slots[Handle.SlotIndex];
+		ParkObject(Slot.Object, Slot.Poolable);
+	}
+
+	return Released.Num();
+}
+
+/**
+ * 解析句柄
+ * 
+ * 功能：返回句柄对应的活跃对象
+ * 设计要点：代数不一致（对象已回收或被复用）时返回nullptr
+ * 
+ * @param Handle 池化句柄
+ * @return 活跃对象指针或nullptr
+ */
+UObject* USDTAPoolManager::ResolveHandle(const FSDTAPoolHandle& Handle) const
 {
+	if (!Handle.IsValid() || !Pools.IsValidIndex(Handle.PoolIndex))
+	{
+		return nullptr;
+	}
+
+	const FPoolConfig& PoolConfig = Pools[Handle.PoolIndex];
+	if (!PoolConfig.Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return nullptr;
+	}
+
+	const FPoolSlot& Slot = PoolConfig.Slots[Handle.SlotIndex];
+	return (Slot.bActive && Slot.Generation == Handle.Generation && IsValid(Slot.Object)) ? Slot.Object.Get() : nullptr;
 }
 
 /**
- * 初始化对象池管理器
+ * 销毁对象池中的全部对象
  * 
- * 功能：设置世界上下文并根据网络模式决定是否启用对象池功能
- * 设计要点：仅在服务器模式下启用对象池，确保网络一致性
+ * 功能：销毁池中所有槽位对象（包括活跃对象），清空槽位
+ * 设计要点：对象池条目保留为空壳，索引不再复用，指向它的旧句柄自然失效
  * 
- * @param InWorld 游戏世界上下文指针，用于对象创建和管理
+ * @param PoolConfig 要清理的对象池
  */
-void USDTAPoolManager::Initialize(UWorld* InWorld)
+void USDTAPoolManager::DestroyPoolObjects(FPoolConfig& PoolConfig)
 {
-	World = InWorld;
-	
-	// 检查是否在服务器上运行
-	if (World && World->GetNetMode() != NM_DedicatedServer && World->GetNetMode() != NM_ListenServer)
+	for (FPoolSlot& Slot : PoolConfig.Slots)
 	{
-		// 如果不在服务器上，禁用对象池功能
-		World = nullptr;
+		if (IsValid(Slot.Object))
+		{
+			if (AActor* Actor = Cast<AActor>(Slot.Object))
+			{
+				Actor->Destroy();
+			}
+			else
+			{
+				Slot.Object->ConditionalBeginDestroy();
+			}
+		}
 	}
+
+	PoolConfig.Slots.Empty();
+	PoolConfig.FreeHead = INDEX_NONE;
+	PoolConfig.EmptyHead = INDEX_NONE;
+	PoolConfig.PooledCount = 0;
+	PoolConfig.ActiveCount = 0;
+	PoolConfig.ReservedSize = 0;
+	PoolConfig.HighWaterMark = 0;
+	PoolConfig.AcquireRate = 0.0f;
+	PoolConfig.Stats = FSDTAPoolStats();
+	PoolConfig.ObjectClass = nullptr;
 }
 
 /**
- * 为特定类初始化对象池
+ * 清除特定类型的对象池
  * 
- * 功能：创建并配置特定类型对象的对象池
- * 设计要点：支持预创建对象、设置最大容量限制，避免重复初始化
+ * 功能：销毁指定类型的所有池化对象和活跃对象，并移除对象池配置
+ * 设计要点：完整的资源清理，避免内存泄漏
  * 
- * @param ObjectClass 要池化的对象类型
- * @param InitialSize 对象池初始大小，预创建的对象数量
- * @param MaxSize 对象池最大大小，-1表示无限制
+ * @param ObjectClass 要清除的对象池类型
  */
-void USDTAPoolManager::InitPoolForClass(TSubclassOf<UObject> ObjectClass, int32 InitialSize, int32 MaxSize)
+void USDTAPoolManager::ClearPool(TSubclassOf<UObject> ObjectClass)
 {
-	if (!World || !ObjectClass || InitialSize < 0)
+	if (!ObjectClass)
 	{
 		return;
 	}
 
 	UClass* Class = ObjectClass.Get();
 
-	// 检查是否已经存在该类型的对象池
-	if (ObjectPools.Contains(Class))
+	// 查找对应的对象池
+	int32 PoolIndex = INDEX_NONE;
+	if (!PoolIndexByClass.RemoveAndCopyValue(Class, PoolIndex))
 	{
 		return;
 	}
 
-	// 创建新的对象池配置
-	FPoolConfig PoolConfig(ObjectClass, MaxSize);
+	// 销毁所有池化对象和活跃对象
+	DestroyPoolObjects(Pools[PoolIndex]);
+}
 
-	// 预创建初始数量的对象
-	for (int32 i = 0; i < InitialSize; ++i)
+/**
+ * 清除所有对象池
+ * 
+ * 功能：销毁所有类型的对象池及其包含的所有对象
+ * 设计要点：批量清理资源，适用于游戏重置或卸载场景
+ */
+void USDTAPoolManager::ClearAllPools()
+{
+	// 遍历所有对象池
+	for (FPoolConfig& PoolConfig : Pools)
 	{
-		UObject* NewObject = CreateNewObject(ObjectClass);
-		if (NewObject)
-		{
-			PoolConfig.PooledObjects.Add(NewObject);
-		}
+		DestroyPoolObjects(PoolConfig);
 	}
 
-	// 将新的对象池添加到映射中
-	ObjectPools.Add(Class, PoolConfig);
+	// 清空映射（池数组保留空壳，保证索引不被复用）
+	PoolIndexByClass.Empty();
+
+	// 取消未完成的预热请求
+	PrewarmQueue.Empty();
 }
 
 /**
- * 从对象池中获取对象
+ * 获取对象池信息
  * 
- * 功能：优先从池中获取对象，如池为空且未达最大容量则创建新对象
- * 设计要点：自动管理对象状态、处理Actor类型特殊逻辑
+ * 功能：返回指定类型对象池的池化对象数和活跃对象数
+ * 设计要点：使用输出参数返回信息，不修改对象池状态
  * 
- * @param ObjectClass 要获取的对象类型
- * @return 返回获取或创建的对象指针，如失败则返回nullptr
+ * @param ObjectClass 要查询的对象池类型
+ * @param OutPooledCount 输出参数：池化对象数量
+ * @param OutActiveCount 输出参数：活跃对象数量
  */
-UObject* USDTAPoolManager::GetObject(TSubclassOf<UObject> ObjectClass)
+void USDTAPoolManager::GetPoolInfo(TSubclassOf<UObject> ObjectClass, int32& OutPooledCount, int32& OutActiveCount) const
 {
-	if (!ObjectClass || !World)
+	OutPooledCount = 0;
+	OutActiveCount = 0;
+
+	if (!ObjectClass)
 	{
-		return nullptr;
+		return;
 	}
 
 	UClass* Class = ObjectClass.Get();
 
-	// 检查是否存在该类型的对象池
-	FPoolConfig* PoolConfig = ObjectPools.Find(Class);
-	if (!PoolConfig)
+	// 查找对应的对象池
+	const int32* PoolIndex = PoolIndexByClass.Find(Class);
+	if (PoolIndex)
 	{
-		// 如果不存在，创建一个默认配置的对象池
-		InitPoolForClass(ObjectClass, 0, -1);
-		PoolConfig = ObjectPools.Find(Class);
-		if (!PoolConfig)
-		{
-			return nullptr;
-		}
+		const FPoolConfig& PoolConfig = Pools[*PoolIndex];
+		OutPooledCount = PoolConfig.PooledCount;
+		OutActiveCount = PoolConfig.ActiveCount;
 	}
+}
 
-	UObject* Object = nullptr;
+/**
+ * 获取对象池需求统计
+ * 
+ * @param ObjectClass 要查询的对象池类型
+ * @param OutHighWaterMark 输出参数：活跃对象数量峰值
+ * @param OutAcquireRate 输出参数：平滑后的获取速率（次/秒）
+ */
+void USDTAPoolManager::GetPoolDemand(TSubclassOf<UObject> ObjectClass, int32& OutHighWaterMark, float& OutAcquireRate) const
+{
+	OutHighWaterMark = 0;
+	OutAcquireRate = 0.0f;
 
-	// 从池中获取对象
-	if (PoolConfig->PooledObjects.Num() > 0)
+	const int32* PoolIndex = ObjectClass ? PoolIndexByClass.Find(ObjectClass.Get()) : nullptr;
+	if (PoolIndex)
 	{
-		Object = PoolConfig->PooledObjects.Last();
-		PoolConfig->PooledObjects.Pop();
+		const FPoolConfig& PoolConfig = Pools[*PoolIndex];
+		OutHighWaterMark = PoolConfig.HighWaterMark;
+		OutAcquireRate = PoolConfig.AcquireRate;
 	}
-	// 如果池为空且未达到最大大小，则创建新对象
-	else if (PoolConfig->MaxSize == -1 || PoolConfig->ActiveObjects.Num() < PoolConfig->MaxSize)
+}
+
+/**
+ * 周期性维护对象池
+ * 
+ * 功能：按维护周期采样每个对象池的获取速率，并据此收缩或扩容
+ * 设计要点：
+ * 1. 获取速率使用指数平滑，避免单个周期的波动触发扩容
+ * 2. 需求上升时按 活跃数 + 速率 × 预测时长 提前分帧扩容，波次开始后不再同步创建
+ * 3. 超过TrimQuietPeriod没有获取操作时，峰值每周期减半衰减，
+ *    空闲对象逐步收缩到 max(保留数量, 活跃数 + MinIdleCount, 峰值 × IdleKeepRatio)
+ * 4. 每周期每池最多销毁TrimBatchSize个对象，有未完成预热请求的对象池不收缩
+ * 5. 先回收对象已在对象池外被销毁的活跃槽位，避免活跃数量只增不减
+ */
+void USDTAPoolManager::MaintainPools()
+{
+	if (!World || !bEnableAdaptiveSizing)
 	{
-		Object = CreateNewObject(ObjectClass);
+		return;
 	}
 
-	// 如果成功获取或创建了对象
-	if (Object)
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_Maintain);
+
+	const double Now = World->GetTimeSeconds();
+
+	for (int32 PoolIndex = 0; PoolIndex < Pools.Num(); ++PoolIndex)
 	{
-		// 将对象标记为活跃
-		PoolConfig->ActiveObjects.Add(Object);
-		ActiveObjectToClassMap.Add(Object, Class);
+		FPoolConfig& PoolConfig = Pools[PoolIndex];
+		if (!PoolConfig.ObjectClass)
+		{
+			continue;
+		}
+
+		RetireDestroyedActiveSlots(PoolIndex);
+
+		// 采样获取速率
+		const float SampleRate = PoolConfig.AcquiresSinceSample / FMath::Max(MaintenanceInterval, KINDA_SMALL_NUMBER);
+		PoolConfig.AcquireRate = FMath::Lerp(PoolConfig.AcquireRate, SampleRate, AcquireRateSmoothing);
+		PoolConfig.AcquiresSinceSample = 0;
+
+		const bool bHasPendingPrewarm = PrewarmQueue.ContainsByPredicate([PoolIndex](const FPrewarmRequest& Request)
+		{
+			return Request.PoolIndex == PoolIndex;
+		});
 
-		// 重置对象状态
-		ResetObject(Object);
+		const bool bQuiet = Now - PoolConfig.LastAcquireTime >= TrimQuietPeriod;
+		if (!bQuiet)
+		{
+			// 需求上升：按近期获取速率提前扩容
+			const int32 PredictedDemand = FMath::CeilToInt(PoolConfig.AcquireRate * GrowLookaheadSeconds);
+			const int32 GrowTarget = PoolConfig.ActiveCount + PredictedDemand;
+			if (PredictedDemand > PoolConfig.PooledCount && GrowTarget > PoolConfig.Num())
+			{
+				QueuePrewarm(PoolIndex, GrowTarget, 0.0f);
+			}
+			continue;
+		}
 
-		// 如果是Actor类型，将其生成到世界中
-		AActor* Actor = Cast<AActor>(Object);
-		if (Actor && !Actor->IsActorInitialized())
+		if (bHasPendingPrewarm)
 		{
-			World->SpawnActorDeferred<AActor>(Actor->GetClass(), FTransform::Identity);
-			Actor->FinishSpawning(FTransform::Identity);
-			Actor->SetActorHiddenInGame(false);
-			Actor->SetActorEnableCollision(true);
-			Actor->SetActorTickEnabled(true);
+			continue;
 		}
-	}
 
-	return Object;
+		// 空闲期：峰值逐步衰减，空闲对象逐步收缩
+		PoolConfig.HighWaterMark = FMath::Max(PoolConfig.ActiveCount, PoolConfig.HighWaterMark / 2);
+
+		const int32 TargetSize = FMath::Max3(
+			PoolConfig.ReservedSize,
+			PoolConfig.ActiveCount + MinIdleCount,
+			FMath::CeilToInt(PoolConfig.HighWaterMark * IdleKeepRatio));
+
+		const int32 Excess = PoolConfig.Num() - TargetSize;
+		if (Excess > 0)
+		{
+			TrimPool(PoolIndex, FMath::Min(Excess, TrimBatchSize));
+		}
+	}
 }
 
 /**
- * 将对象回收到对象池中
+ * 收缩对象池
  * 
- * 功能：将活跃对象从世界中移除并重置状态，放回池中待复用
- * 设计要点：完善的安全检查、自动重置对象状态、优化渲染和物理性能
+ * 功能：从空闲链表头取出对象并销毁，槽位转入空槽位链表等待复用
+ * 设计要点：只销毁空闲对象；槽位代数递增，旧句柄随之失效
  * 
- * @param Object 要回收的对象指针
- * @return 回收成功返回true，失败返回false
+ * @param PoolIndex 对象池索引
+ * @param Count 要销毁的对象数量
+ * @return 实际销毁的数量
  */
-bool USDTAPoolManager::ReturnObject(UObject* Object)
+int32 USDTAPoolManager::TrimPool(int32 PoolIndex, int32 Count)
 {
-	if (!World || !Object)
-	{
-		return false;
-	}
-
-	// 查找对象所属的类
-	UClass** ClassPtr = ActiveObjectToClassMap.Find(Object);
-	if (!ClassPtr)
-	{
-		return false;
-	}
+	FPoolConfig& PoolConfig = Pools[PoolIndex];
 
-	UClass* Class = *ClassPtr;
-
-	// 查找对应的对象池
-	FPoolConfig* PoolConfig = ObjectPools.Find(Class);
-	if (!PoolConfig)
+	int32 TrimmedCount = 0;
+	while (TrimmedCount < Count && PoolConfig.FreeHead != INDEX_NONE)
 	{
-		return false;
-	}
+		const int32 SlotIndex = PoolConfig.FreeHead;
+		FPoolSlot& Slot = PoolConfig.Slots[SlotIndex];
+		PoolConfig.FreeHead = Slot.NextFree;
 
-	// 从活跃对象数组中移除
-	PoolConfig->ActiveObjects.Remove(Object);
-	ActiveObjectToClassMap.Remove(Object);
-
-	// 将对象放回池中
-	PoolConfig->PooledObjects.Add(Object);
+		if (IsValid(Slot.Object))
+		{
+			if (AActor* Actor = Cast<AActor>(Slot.Object))
+			{
+				Actor->Destroy();
+			}
+			else
+			{
+				Slot.Object->ConditionalBeginDestroy();
+			}
+		}
 
-	// 如果是Actor类型，将其从世界中隐藏
-	AActor* Actor = Cast<AActor>(Object);
-	if (Actor)
-	{
-		Actor->SetActorHiddenInGame(true);
-		Actor->SetActorEnableCollision(false);
-		Actor->SetActorTickEnabled(false);
-		
-		// 保持网络复制属性正确设置
-		Actor->SetReplicates(true);
-		Actor->SetReplicateMovement(true);
-		
-		Actor->SetActorLocation(FVector::ZeroVector);
-		Actor->SetActorRotation(FRotator::ZeroRotator);
+		// 槽位转入空槽位链表
+		RetireSlot(PoolIndex, SlotIndex);
+		TrimmedCount++;
 	}
 
-	return true;
+	return TrimmedCount;
 }
 
 /**
- * 清除特定类型的对象池
+ * 将槽位转入空槽位链表
  * 
- * 功能：销毁指定类型的所有池化对象和活跃对象，并移除对象池配置
- * 设计要点：完整的资源清理，避免内存泄漏
+ * 功能：清空槽位中的对象并按槽位原来的状态减少空闲或活跃数量
+ * 设计要点：空闲槽位需由调用方先从空闲链表中取出，这里只修改空槽位链表
  * 
- * @param ObjectClass 要清除的对象池类型
+ * @param PoolIndex 对象池索引
+ * @param SlotIndex 槽位索引
  */
-void USDTAPoolManager::ClearPool(TSubclassOf<UObject> ObjectClass)
+void USDTAPoolManager::RetireSlot(int32 PoolIndex, int32 SlotIndex)
 {
-	if (!ObjectClass)
+	FPoolConfig& PoolConfig = Pools[PoolIndex];
+	FPoolSlot& Slot = PoolConfig.Slots[SlotIndex];
+
+	if (Slot.bActive)
 	{
-		return;
+		PoolConfig.ActiveCount--;
 	}
-
-	UClass* Class = ObjectClass.Get();
-
-	// 查找对应的对象池
-	FPoolConfig* PoolConfig = ObjectPools.Find(Class);
-	if (!PoolConfig)
+	else
 	{
-		return;
+		PoolConfig.PooledCount--;
 	}
 
-	// 销毁所有池化对象
-	for (UObject* Object : PoolConfig->PooledObjects)
+	Slot.Object = nullptr;
+	Slot.Poolable = nullptr;
+	Slot.bActive = false;
+	Slot.Generation++;
+	Slot.NextFree = PoolConfig.EmptyHead;
+	PoolConfig.EmptyHead = SlotIndex;
+}
+
+/**
+ * 回收对象已在对象池外被销毁的活跃槽位
+ * 
+ * 功能：借出后被直接销毁的对象不会再回收，维护时找出这些槽位并转入空槽位链表
+ * 
+ * @param PoolIndex 对象池索引
+ * @return 回收的槽位数量
+ */
+int32 USDTAPoolManager::RetireDestroyedActiveSlots(int32 PoolIndex)
+{
+	int32 RetiredCount = 0;
+	for (int32 SlotIndex = 0; SlotIndex < Pools[PoolIndex].Slots.Num(); ++SlotIndex)
 	{
-		if (Object)
+		const FPoolSlot& Slot = Pools[PoolIndex].Slots[SlotIndex];
+		if (Slot.bActive && !IsValid(Slot.Object))
 		{
-			Object->ConditionalBeginDestroy();
+			RetireSlot(PoolIndex, SlotIndex);
+			RetiredCount++;
 		}
 	}
 
-	// 销毁所有活跃对象
-	for (UObject* Object : PoolConfig->ActiveObjects)
+	if (RetiredCount > 0)
 	{
-		if (Object)
-		{
-			ActiveObjectToClassMap.Remove(Object);
-			Object->ConditionalBeginDestroy();
-		}
+		UE_LOG(LogSDTAPool, Verbose, TEXT("[SDTAPool] %s: %d 个借出的对象已在对象池外被销毁"),
+			*GetNameSafe(Pools[PoolIndex].ObjectClass.Get()), RetiredCount);
 	}
 
-	// 清除对象池
-	PoolConfig->PooledObjects.Empty();
-	PoolConfig->ActiveObjects.Empty();
-	ObjectPools.Remove(Class);
+	return RetiredCount;
 }
 
 /**
- * 清除所有对象池
+ * 记录被拒绝的回收
  * 
- * 功能：销毁所有类型的对象池及其包含的所有对象
- * 设计要点：批量清理资源，适用于游戏重置或卸载场景
+ * @param PoolIndex 对象池索引，无法定位对象池时为INDEX_NONE
+ * @param Object 被拒绝回收的对象
  */
-void USDTAPoolManager::ClearAllPools()
+void USDTAPoolManager::RecordRejectedReturn(int32 PoolIndex, const UObject* Object)
 {
-	// 遍历所有对象池
-	for (auto& PoolPair : ObjectPools)
-	{
-		FPoolConfig& PoolConfig = PoolPair.Value;
-
-		// 销毁所有池化对象
-		for (UObject* Object : PoolConfig.PooledObjects)
-		{
-			if (Object)
-			{
-				Object->ConditionalBeginDestroy();
-			}
-		}
+	INC_DWORD_STAT(STAT_SDTAPool_RejectedReturns);
 
-		// 销毁所有活跃对象
-		for (UObject* Object : PoolConfig.ActiveObjects)
-		{
-			if (Object)
-			{
-				ActiveObjectToClassMap.Remove(Object);
-				Object->ConditionalBeginDestroy();
-			}
-		}
+	if (Pools.IsValidIndex(PoolIndex))
+	{
+		Pools[PoolIndex].Stats.RejectedReturns++;
 	}
 
-	// 清空所有映射
-	ObjectPools.Empty();
-	ActiveObjectToClassMap.Empty();
+	UE_LOG(LogSDTAPool, Verbose, TEXT("[SDTAPool] 拒绝回收: %s"), *GetNameSafe(Object));
 }
 
 /**
- * 获取对象池信息
+ * 获取对象池统计数据
  * 
- * 功能：返回指定类型对象池的池化对象数和活跃对象数
- * 设计要点：使用输出参数返回信息，不修改对象池状态
+ * 功能：返回指定类型对象池的累计统计，并计算平均值
  * 
  * @param ObjectClass 要查询的对象池类型
- * @param OutPooledCount 输出参数：池化对象数量
- * @param OutActiveCount 输出参数：活跃对象数量
+ * @param OutStats 输出参数：统计数据
+ * @return 对象池存在返回true
  */
-void USDTAPoolManager::GetPoolInfo(TSubclassOf<UObject> ObjectClass, int32& OutPooledCount, int32& OutActiveCount) const
+bool USDTAPoolManager::GetPoolStats(TSubclassOf<UObject> ObjectClass, FSDTAPoolStats& OutStats) const
 {
-	OutPooledCount = 0;
-	OutActiveCount = 0;
+	OutStats = FSDTAPoolStats();
 
-	if (!ObjectClass)
+	const int32* PoolIndex = ObjectClass ? PoolIndexByClass.Find(ObjectClass.Get()) : nullptr;
+	if (!PoolIndex)
 	{
-		return;
+		return false;
 	}
 
-	UClass* Class = ObjectClass.Get();
+	OutStats = Pools[*PoolIndex].Stats;
+	if (OutStats.Acquisitions > 0)
+	{
+		OutStats.AverageTimeInPool = static_cast<float>(OutStats.TotalTimeInPool / OutStats.Acquisitions);
+		OutStats.AverageResetMicroseconds = static_cast<float>(OutStats.TotalResetSeconds * 1000000.0 / OutStats.Acquisitions);
+	}
 
-	// 查找对应的对象池
-	const FPoolConfig* PoolConfig = ObjectPools.Find(Class);
-	if (PoolConfig)
+	return true;
+}
+
+/**
+ * 输出所有对象池的统计数据
+ * 
+ * 功能：按对象池逐行输出容量、需求和遥测统计，供控制台命令和调试使用
+ * 
+ * @param Ar 输出设备
+ */
+void USDTAPoolManager::DumpPoolStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("[SDTAPool] 对象池数量: %d"), PoolIndexByClass.Num());
+
+	for (const TPair<UClass*, int32>& Pair : PoolIndexByClass)
 	{
-		OutPooledCount = PoolConfig->PooledObjects.Num();
-		OutActiveCount = PoolConfig->ActiveObjects.Num();
+		const FPoolConfig& PoolConfig = Pools[Pair.Value];
+
+		FSDTAPoolStats Stats;
+		GetPoolStats(Pair.Key, Stats);
+
+		Ar.Logf(TEXT("[SDTAPool] %s: 空闲=%d 活跃=%d 上限=%d 保留=%d | 获取=%d 未命中=%d 回收=%d 拒绝回收=%d 活跃峰值=%d | 池中平均停留=%.2fs 平均重置=%.1fus | 获取速率=%.2f/s"),
+			*GetNameSafe(Pair.Key),
+			PoolConfig.PooledCount,
+			PoolConfig.ActiveCount,
+			PoolConfig.MaxSize,
+			PoolConfig.ReservedSize,
+			Stats.Acquisitions,
+			Stats.Misses,
+			Stats.Returns,
+			Stats.RejectedReturns,
+			Stats.PeakActive,
+			Stats.AverageTimeInPool,
+			Stats.AverageResetMicroseconds,
+			PoolConfig.AcquireRate);
 	}
 }
 
+/**
+ * 检查对象池是否存在
+ * 
+ * @param ObjectClass 要查询的对象池类型
+ * @return 对象池已存在返回true
+ */
+bool USDTAPoolManager::HasPool(TSubclassOf<UObject> ObjectClass) const
+{
+	return ObjectClass && PoolIndexByClass.Contains(ObjectClass.Get());
+}
+
 /**
  * 创建新对象
  * 
@@ -377,19 +1419,27 @@ UObject* USDTAPoolManager::CreateNewObject(TSubclassOf<UObject> ObjectClass)
 		return nullptr;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_Create);
+
 	UObject* NewObject = nullptr;
 
 	// 根据对象类型创建实例
 	if (ObjectClass->IsChildOf<AActor>())
 	{
 		// 创建Actor类型的对象
-		NewObject = World->SpawnActorDeferred<AActor>(ObjectClass, FTransform::Identity);
+		// 池化对象统一生成在原点并隐藏，忽略生成点碰撞，避免预热时因重叠而生成失败
+		NewObject = World->SpawnActorDeferred<AActor>(ObjectClass, FTransform::Identity, nullptr, nullptr,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
 		if (NewObject)
 		{
 			AActor* NewActor = Cast<AActor>(NewObject);
-			// 设置网络复制属性
-			NewActor->SetReplicates(true);
-			NewActor->SetReplicateMovement(true);
+
+			// 复制属性以类默认值为准，客户端池化的表现类对象保持不复制；
+			// 复制的对象以休眠状态进入对象池，借出前不会复制到客户端
+			if (NewActor->GetIsReplicated())
+			{
+				NewActor->NetDormancy = DORM_DormantAll;
+			}
 			
 			// 完成Actor生成
 			NewActor->FinishSpawning(FTransform::Identity);
@@ -417,69 +1467,82 @@ UObject* USDTAPoolManager::CreateNewObject(TSubclassOf<UObject> ObjectClass)
 /**
  * 重置对象状态
  * 
- * 功能：恢复对象的初始状态，为复用做准备
- * 设计要点：支持敌人对象的特殊处理，重置物理和运动组件
+ * 功能：在对象借出时将其恢复到可用状态
+ * 设计要点：
+ * 1. 实现ISDTAPoolable的对象由自身的OnAcquiredFromPool完成重置，只重置需要的状态
+ * 2. 其他Actor只恢复可见性、碰撞和Tick，位置由调用方在借出后设置
+ * 3. 复制的Actor在重置前先唤醒网络休眠
  * 
- * @param Object 要重置的对象指针
+ * @param Object 要重置的对象
+ * @param Poolable 对象的可池化接口（槽位中缓存），为nullptr时走通用逻辑
+ * @param Handle 本次借出对应的句柄
  */
-void USDTAPoolManager::ResetObject(UObject* Object)
+void USDTAPoolManager::ResetObject(UObject* Object, ISDTAPoolable* Poolable, const FSDTAPoolHandle& Handle)
 {
 	if (!World || !Object)
 	{
 		return;
 	}
 
-	// 这里可以根据需要重置对象的状态
-	// 例如，对于Actor可以重置位置、旋转、速度等
+	SCOPE_CYCLE_COUNTER(STAT_SDTAPool_Reset);
+
 	AActor* Actor = Cast<AActor>(Object);
-	if (Actor)
+
+	// 先唤醒网络休眠，借出后的状态变化（显示、位置等）才会复制到客户端
+	if (Actor && Actor->GetIsReplicated())
 	{
-		// 检查是否是EnemyBase类型
-		AEnemyBase* Enemy = Cast<AEnemyBase>(Actor);
-		if (Enemy)
-		{
-			// 调用EnemyBase的Reset方法，确保敌人状态完全重置
-			Enemy->Reset();
-			return;
-		}
+		Actor->SetNetDormancy(DORM_Awake);
+	}
 
-		// 检查是否是WorkStation类型
-		class AWorkStation* WorkStation = Cast<AWorkStation>(Actor);
-		if (WorkStation)
-		{
-			// 调用WorkStation的Reset方法，确保工作台状态完全重置
-			WorkStation->Reset();
-			return;
-		}
+	if (Poolable)
+	{
+		Poolable->PoolHandle = Handle;
+		Poolable->OnAcquiredFromPool(Handle);
+		return;
+	}
 
-		// 通用Actor重置
-		Actor->SetActorLocation(FVector::ZeroVector);
-		Actor->SetActorRotation(FRotator::ZeroRotator);
-		Actor->SetActorScale3D(FVector::OneVector);
+	// 通用Actor重置
+	if (Actor)
+	{
+		Actor->SetActorHiddenInGame(false);
 		Actor->SetActorEnableCollision(true);
 		Actor->SetActorTickEnabled(true);
-		Actor->SetActorHiddenInGame(false);
+	}
+}
+
+/**
+ * 停放对象
+ * 
+ * 功能：在对象回收时停止其运行逻辑，并将Actor从世界中隐藏
+ * 设计要点：
+ * 1. 先通知对象自身停止定时器、移动等逻辑，再统一隐藏并移到原点
+ * 2. 停放的Actor进入网络休眠，服务器开销不再随对象池大小增长
+ * 
+ * @param Object 要停放的对象
+ * @param Poolable 对象的可池化接口（槽位中缓存），为nullptr时只做通用处理
+ */
+void USDTAPoolManager::ParkObject(UObject* Object, ISDTAPoolable* Poolable)
+{
+	if (Poolable)
+	{
+		Poolable->OnReleasedToPool();
+	}
 
-		// 重置网络复制属性
-		Actor->SetReplicates(true);
-		Actor->SetReplicateMovement(true);
+	// 如果是Actor类型，将其从世界中隐藏
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Actor->SetActorHiddenInGame(true);
+		Actor->SetActorEnableCollision(false);
+		Actor->SetActorTickEnabled(false);
 
-		// 重置运动组件
-		UProjectileMovementComponent* ProjectileMovementComp = Actor->FindComponentByClass<UProjectileMovementComponent>();
-		if (ProjectileMovementComp)
-		{
-			ProjectileMovementComp->Velocity = FVector::ZeroVector;
-			ProjectileMovementComp->SetActive(true);
-		}
+		Actor->SetActorLocation(FVector::ZeroVector);
+		Actor->SetActorRotation(FRotator::ZeroRotator);
 
-		// 重置碰撞组件
-		UPrimitiveComponent* CollisionComponent = Actor->FindComponentByClass<UPrimitiveComponent>();
-		if (CollisionComponent)
+		// 进入网络休眠：隐藏状态随休眠前的最后一次复制发送到客户端，
+		// 之后停放期间不再参与服务器的网络相关性检查和属性比较
+		if (Actor->GetIsReplicated())
 		{
-			CollisionComponent->SetPhysicsLinearVelocity(FVector::ZeroVector);
-			CollisionComponent->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-			CollisionComponent->SetSimulatePhysics(false);
-			CollisionComponent->SetSimulatePhysics(true);
+			Actor->SetNetDormancy(DORM_DormantAll);
 		}
 	}
-}
\ No newline at end of file
+}
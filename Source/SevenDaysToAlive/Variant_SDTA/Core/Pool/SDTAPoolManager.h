@@ -4,36 +4,131 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Subsystems/WorldSubsystem.h"
 #include "Containers/Array.h"
 #include "Containers/Map.h"
 #include "Templates/Function.h"
+#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 #include "SDTAPoolManager.generated.h"
 
+/** 自定义日志类别：对象池 */
+DECLARE_LOG_CATEGORY_EXTERN(LogSDTAPool, Log, All);
+
+// 前向声明
+class ISDTAPoolable;
+
+/**
+ * 池化对象句柄
+ *
+ * 由池索引、槽位索引和代数组成：
+ * - PoolIndex/SlotIndex 直接定位到槽位，无需哈希查找
+ * - Generation 在对象每次回收时递增，旧句柄会自动失效，避免对象复用后被误操作
+ */
+USTRUCT()
+struct SEVENDAYSTOALIVE_API FSDTAPoolHandle
+{
+	GENERATED_BODY()
+
+	int32 PoolIndex = INDEX_NONE; // 所属对象池索引
+	int32 SlotIndex = INDEX_NONE; // 池内槽位索引
+	uint32 Generation = 0; // 槽位代数
+
+	FSDTAPoolHandle() {}
+	FSDTAPoolHandle(int32 InPoolIndex, int32 InSlotIndex, uint32 InGeneration)
+		: PoolIndex(InPoolIndex), SlotIndex(InSlotIndex), Generation(InGeneration) {}
+
+	/** 句柄是否指向某个槽位（不保证该槽位仍处于同一代） */
+	bool IsValid() const { return PoolIndex != INDEX_NONE && SlotIndex != INDEX_NONE; }
+
+	/** 重置为无效句柄 */
+	void Invalidate() { *this = FSDTAPoolHandle(); }
+
+	bool operator==(const FSDTAPoolHandle& Other) const
+	{
+		return PoolIndex == Other.PoolIndex && SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+	}
+	bool operator!=(const FSDTAPoolHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * 对象池统计数据
+ *
+ * 按对象类统计，用于根据实际数据调整对象池大小
+ */
+USTRUCT(BlueprintType)
+struct SEVENDAYSTOALIVE_API FSDTAPoolStats
+{
+	GENERATED_BODY()
+
+	/** 获取次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	int32 Acquisitions = 0;
+
+	/** 未命中次数（空闲链表为空，需要调用CreateNewObject） */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	int32 Misses = 0;
+
+	/** 回收次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	int32 Returns = 0;
+
+	/** 被拒绝的回收次数（重复回收、过期句柄或非池化对象） */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	int32 RejectedReturns = 0;
+
+	/** 活跃对象数量峰值（不随空闲收缩衰减） */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	int32 PeakActive = 0;
+
+	/** 对象在池中的平均停留时间（秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	float AverageTimeInPool = 0.0f;
+
+	/** 平均重置耗时（微秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "对象池|统计")
+	float AverageResetMicroseconds = 0.0f;
+
+	/** 累计在池中停留时间（秒），用于计算平均值 */
+	double TotalTimeInPool = 0.0;
+
+	/** 累计重置耗时（秒），用于计算平均值 */
+	double TotalResetSeconds = 0.0;
+};
+
+// 异步预热进度事件
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnPoolPrewarmProgress, UClass*, ObjectClass, int32, CreatedCount, int32, TargetCount);
+
+// 异步预热完成事件
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPoolPrewarmCompleted, UClass*, ObjectClass, int32, PoolSize);
+
 /**
  * 通用对象池管理器，支持多类型对象的池化管理
- * 
+ *
  * 核心功能：
  * 1. 管理多种类型的对象池，支持Actor和UObject类型
  * 2. 提供对象的高效获取和回收机制，减少频繁创建和销毁对象的性能开销
- * 3. 支持服务器端权威管理，确保网络一致性
+ * 3. 支持服务器端权威管理，确保网络一致性；客户端只允许池化不复制的表现类对象（曳光、弹孔、弹壳等）
  * 4. 提供灵活的对象池配置（初始大小、最大大小等）
  * 5. 支持对象状态重置和生命周期管理
- * 
+ *
  * 设计理念：
  * - 采用模板化设计，支持多种对象类型
  * - 实现服务器端权威制，确保网络环境下的一致性
  * - 提供简洁易用的接口，便于集成到游戏系统中
  * - 支持对象的自动状态重置和激活/休眠管理
- * 
+ * - 槽位+空闲链表存储，配合带代数的句柄实现O(1)获取和回收
+ * - 槽位对GC报告对象引用；在对象池外被销毁的对象（关卡卸载、直接Destroy）在借出、回收和维护时被识别，其槽位转入空槽位链表
+ * - 作为世界子系统随世界创建和销毁，通过USDTAPoolManager::Get直接获取，无需经过GameMode
+ *
  * 使用场景：
  * - 敌人对象的高效回收和复用
  * - 项目ilectile等频繁创建/销毁的游戏对象
  * - UI元素的动态管理
  * - 任何需要高性能对象管理的场景
  */
-UCLASS(Blueprintable, BlueprintType)
-class SEVENDAYSTOALIVE_API USDTAPoolManager : public UObject
+UCLASS(BlueprintType)
+class SEVENDAYSTOALIVE_API USDTAPoolManager : public UWorldSubsystem
 {
 	GENERATED_BODY()
 
@@ -42,11 +137,28 @@ public:
 	USDTAPoolManager();
 
 	/**
-	 * 初始化对象池管理器
-	 * @param InWorld 世界上下文
+	 * 获取世界中的对象池管理器
+	 * @param WorldContextObject 世界上下文对象
+	 * @return 对象池管理器，编辑器预览等不支持的世界返回nullptr
 	 */
-	UFUNCTION(BlueprintCallable, Category = "对象池")
-	void Initialize(UWorld* InWorld);
+	UFUNCTION(BlueprintPure, Category = "对象池", meta = (WorldContext = "WorldContextObject"))
+	static USDTAPoolManager* Get(const UObject* WorldContextObject);
+
+	// USubsystem接口
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// UObject接口：向GC报告槽位中的对象
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	// UWorldSubsystem接口
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	// 只在游戏世界（含PIE）中创建
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
 
 	/**
 	 * 为特定类型的对象初始化对象池
@@ -57,6 +169,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "对象池")
 	void InitPoolForClass(TSubclassOf<UObject> ObjectClass, int32 InitialSize, int32 MaxSize = -1);
 
+	/**
+	 * 分帧异步预热对象池
+	 * 每帧在时间预算内创建对象，直到池中对象总数达到目标数量
+	 * 对同一类型重复调用时合并为一个请求，目标数量取较大值
+	 * @param ObjectClass 要池化的对象类
+	 * @param TargetSize 预热完成后池中对象总数（含活跃对象）
+	 * @param MaxSize 最大池大小，仅在对象池尚未创建时生效
+	 * @param BudgetMs 每帧创建对象的时间预算（毫秒），<=0时使用PrewarmBudgetMs
+	 */
+	UFUNCTION(BlueprintCallable, Category = "对象池")
+	void PrewarmPoolAsync(TSubclassOf<UObject> ObjectClass, int32 TargetSize, int32 MaxSize = -1, float BudgetMs = 0.0f);
+
+	/**
+	 * 是否有未完成的异步预热请求
+	 */
+	UFUNCTION(BlueprintPure, Category = "对象池")
+	bool IsPrewarming() const { return PrewarmQueue.Num() > 0; }
+
 	/**
 	 * 从对象池中获取指定类型的对象
 	 * @param ObjectClass 要获取的对象类
@@ -65,14 +195,68 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "对象池")
 	UObject* GetObject(TSubclassOf<UObject> ObjectClass);
 
+	/**
+	 * 从对象池中获取指定类型的对象，并返回其句柄
+	 * 持有句柄的调用方可通过ReleaseObject以O(1)回收对象
+	 * @param ObjectClass 要获取的对象类
+	 * @param OutHandle 输出：对象的池化句柄，失败时为无效句柄
+	 * @return 获取到的对象，失败返回nullptr
+	 */
+	UObject* GetObjectWithHandle(TSubclassOf<UObject> ObjectClass, FSDTAPoolHandle& OutHandle);
+
 	/**
 	 * 将对象回收回对象池
+	 * 通过ISDTAPoolable保存的句柄定位槽位；未实现该接口的对象需通过ReleaseObject按句柄回收
 	 * @param Object 要回收的对象
 	 * @return 是否成功回收
 	 */
 	UFUNCTION(BlueprintCallable, Category = "对象池")
 	bool ReturnObject(UObject* Object);
 
+	/**
+	 * 对象是否由对象池创建（无论当前是否借出）
+	 * 回收失败时调用方据此判断能否直接销毁对象，避免销毁仍在空闲链表中的对象
+	 * @param Object 要检查的对象
+	 * @return 对象占有对象池的槽位时返回true
+	 */
+	bool OwnsObject(const UObject* Object) const;
+
+	/**
+	 * 通过句柄回收对象（无哈希查找、无线性扫描）
+	 * @param Handle 获取对象时得到的句柄
+	 * @return 是否成功回收；句柄过期或对象已回收时返回false
+	 */
+	bool ReleaseObject(const FSDTAPoolHandle& Handle);
+
+	/**
+	 * 解析句柄对应的活跃对象
+	 * @param Handle 池化句柄
+	 * @return 句柄仍有效且对象处于活跃状态时返回对象，否则返回nullptr
+	 */
+	UObject* ResolveHandle(const FSDTAPoolHandle& Handle) const;
+
+	/**
+	 * 批量获取同一类型的对象
+	 * 只查找一次对象池；对象先在隐藏状态下放置到目标变换，再统一重置和显示
+	 * @param ObjectClass 要获取的对象类
+	 * @param Count 获取数量
+	 * @param Transforms 每个对象的目标变换，数量不足时其余对象停留在原点
+	 * @param OutObjects 输出：获取到的对象，达到池最大大小时可能少于Count
+	 * @return 实际获取数量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "对象池")
+	int32 AcquireBatch(TSubclassOf<UObject> ObjectClass, int32 Count, const TArray<FTransform>& Transforms, TArray<UObject*>& OutObjects);
+
+	/**
+	 * 批量回收对象
+	 * 先完成所有槽位的回收，再统一停放（隐藏、关闭碰撞、进入网络休眠）
+	 * @param Objects 要回收的对象，可以来自不同的对象池
+	 * @param OutRejected 输出：无法回收的对象（非池化对象或已回收），由调用方自行处理
+	 * @return 成功回收的数量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "对象池")
+	int32 ReleaseBatch(const TArray<UObject*>& Objects, TArray<UObject*>& OutRejected);
+
 	/**
 	 * 清除指定类型的对象池
 	 * @param ObjectClass 要清除的对象类型
@@ -95,7 +279,99 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "对象池")
 	void GetPoolInfo(TSubclassOf<UObject> ObjectClass, int32& OutPooledCount, int32& OutActiveCount) const;
 
+	/**
+	 * 检查指定类型的对象池是否已创建
+	 * @param ObjectClass 对象类型
+	 * @return 对象池已存在返回true
+	 */
+	UFUNCTION(BlueprintPure, Category = "对象池")
+	bool HasPool(TSubclassOf<UObject> ObjectClass) const;
+
+	/** 默认每帧预热时间预算（毫秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|预热", meta = (ClampMin = 0.1))
+	float PrewarmBudgetMs;
+
+	/** 异步预热进度事件，每帧对每个推进过的请求触发一次 */
+	UPROPERTY(BlueprintAssignable, Category = "对象池|预热")
+	FOnPoolPrewarmProgress OnPoolPrewarmProgress;
+
+	/** 异步预热完成事件 */
+	UPROPERTY(BlueprintAssignable, Category = "对象池|预热")
+	FOnPoolPrewarmCompleted OnPoolPrewarmCompleted;
+
+	/**
+	 * 获取指定类型对象池的需求统计
+	 * @param ObjectClass 对象类型
+	 * @param OutHighWaterMark 活跃对象数量峰值（空闲期间逐步衰减）
+	 * @param OutAcquireRate 近期平均获取速率（次/秒）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "对象池|自适应")
+	void GetPoolDemand(TSubclassOf<UObject> ObjectClass, int32& OutHighWaterMark, float& OutAcquireRate) const;
+
+	/**
+	 * 获取指定类型对象池的统计数据
+	 * @param ObjectClass 对象类型
+	 * @param OutStats 输出：统计数据
+	 * @return 对象池存在返回true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "对象池|统计")
+	bool GetPoolStats(TSubclassOf<UObject> ObjectClass, FSDTAPoolStats& OutStats) const;
+
+	/**
+	 * 输出所有对象池的统计数据
+	 * @param Ar 输出设备（控制台或日志）
+	 */
+	void DumpPoolStats(FOutputDevice& Ar) const;
+
+	/** 是否启用自适应容量（空闲收缩与按需提前扩容） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应")
+	bool bEnableAdaptiveSizing;
+
+	/** 维护周期（秒），每个周期采样获取速率并执行收缩/扩容 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 0.1))
+	float MaintenanceInterval;
+
+	/** 空闲时长（秒），对象池超过该时长没有获取操作才开始收缩 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 0))
+	float TrimQuietPeriod;
+
+	/** 收缩时保留的最少空闲对象数量 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 0))
+	int32 MinIdleCount;
+
+	/** 收缩时按峰值保留的比例（0-1） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 0, ClampMax = 1))
+	float IdleKeepRatio;
+
+	/** 每个维护周期每个对象池最多销毁的对象数量，避免收缩本身造成卡顿 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 1))
+	int32 TrimBatchSize;
+
+	/** 提前扩容的预测时长（秒），按近期获取速率预留该时长内的需求 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 0))
+	float GrowLookaheadSeconds;
+
+	/** 获取速率的平滑系数（0-1），越大越偏向最近一个周期 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "对象池|自适应", meta = (ClampMin = 0.01, ClampMax = 1))
+	float AcquireRateSmoothing;
+
 protected:
+	/**
+	 * 对象池槽位
+	 * 每个池化对象在创建时分配一个固定槽位，直到对象池被清除
+	 */
+	struct FPoolSlot
+	{
+		TObjectPtr<UObject> Object; // 槽位中的对象（由AddReferencedObjects报告给GC，对象被销毁后为空或不再有效）
+		uint32 Generation; // 槽位代数，每次回收时递增
+		int32 NextFree; // 空闲链表中的下一个槽位
+		bool bActive; // 是否处于活跃（已借出）状态
+		double ReleaseTime; // 最近一次进入空闲链表的世界时间
+		ISDTAPoolable* Poolable; // 缓存的可池化接口指针，未实现接口时为nullptr
+
+		FPoolSlot() : Object(nullptr), Generation(0), NextFree(INDEX_NONE), bActive(false), ReleaseTime(0.0), Poolable(nullptr) {}
+	};
+
 	/**
 	 * 对象池配置结构体
 	 */
@@ -103,14 +379,83 @@ protected:
 	{
 		TSubclassOf<UObject> ObjectClass; // 对象类型
 		int32 MaxSize; // 最大池大小，-1表示无限制
-		TArray<UObject*> PooledObjects; // 池化对象数组
-		TArray<UObject*> ActiveObjects; // 活跃对象数组
+		TArray<FPoolSlot> Slots; // 槽位数组
+		int32 FreeHead; // 空闲链表头
+		int32 EmptyHead; // 空槽位链表头（对象已被收缩销毁的槽位）
+		int32 PooledCount; // 池化（空闲）对象数量
+		int32 ActiveCount; // 活跃对象数量
+		int32 ReservedSize; // 显式预热的目标数量，收缩不会低于该值
+		bool bPoolable; // 对象类型是否实现ISDTAPoolable（创建对象池时缓存）
+
+		// 需求统计
+		int32 HighWaterMark; // 活跃对象数量峰值
+		int32 AcquiresSinceSample; // 本采样周期内的获取次数
+		float AcquireRate; // 平滑后的获取速率（次/秒）
+		double LastAcquireTime; // 最近一次获取的世界时间
+
+		// 遥测统计
+		FSDTAPoolStats Stats;
 
 		// 构造函数
-		FPoolConfig() : MaxSize(-1) {}
-		FPoolConfig(TSubclassOf<UObject> InClass, int32 InMaxSize) : ObjectClass(InClass), MaxSize(InMaxSize) {}
+		FPoolConfig() : MaxSize(-1), FreeHead(INDEX_NONE), EmptyHead(INDEX_NONE), PooledCount(0), ActiveCount(0), ReservedSize(0), bPoolable(false), HighWaterMark(0), AcquiresSinceSample(0), AcquireRate(0.0f), LastAcquireTime(0.0) {}
+		FPoolConfig(TSubclassOf<UObject> InClass, int32 InMaxSize) : ObjectClass(InClass), MaxSize(InMaxSize), FreeHead(INDEX_NONE), EmptyHead(INDEX_NONE), PooledCount(0), ActiveCount(0), ReservedSize(0), bPoolable(false), HighWaterMark(0), AcquiresSinceSample(0), AcquireRate(0.0f), LastAcquireTime(0.0) {}
+
+		/** 池中对象总数（空闲+活跃，不含空槽位） */
+		int32 Num() const { return PooledCount + ActiveCount; }
 	};
 
+	/**
+	 * 异步预热请求
+	 */
+	struct FPrewarmRequest
+	{
+		int32 PoolIndex; // 对象池索引
+		int32 TargetSize; // 目标对象总数
+		float BudgetMs; // 每帧时间预算（毫秒）
+
+		FPrewarmRequest() : PoolIndex(INDEX_NONE), TargetSize(0), BudgetMs(0.0f) {}
+		FPrewarmRequest(int32 InPoolIndex, int32 InTargetSize, float InBudgetMs) : PoolIndex(InPoolIndex), TargetSize(InTargetSize), BudgetMs(InBudgetMs) {}
+	};
+
+	/**
+	 * 处理异步预热队列
+	 * 按队列顺序在时间预算内创建对象，未完成时在下一帧继续
+	 */
+	void ProcessPrewarmQueue();
+
+	/**
+	 * 安排下一帧处理预热队列
+	 */
+	void SchedulePrewarmTick();
+
+	/**
+	 * 登记预热请求（不修改对象池的保留数量）
+	 */
+	void QueuePrewarm(int32 PoolIndex, int32 TargetSize, float BudgetMs);
+
+	/**
+	 * 周期性维护：采样获取速率，空闲时收缩，需求上升时提前扩容
+	 */
+	void MaintainPools();
+
+	/**
+	 * 从空闲链表中销毁指定数量的对象，槽位转入空槽位链表
+	 * @return 实际销毁的数量
+	 */
+	int32 TrimPool(int32 PoolIndex, int32 Count);
+
+	/**
+	 * 将槽位转入空槽位链表并更新计数，代数递增使旧句柄失效
+	 * 空闲槽位需由调用方先从空闲链表中取出
+	 */
+	void RetireSlot(int32 PoolIndex, int32 SlotIndex);
+
+	/**
+	 * 回收对象已在对象池外被销毁的活跃槽位
+	 * @return 回收的槽位数量
+	 */
+	int32 RetireDestroyedActiveSlots(int32 PoolIndex);
+
 	/**
 	 * 创建新的对象实例
 	 * @param ObjectClass 对象类
@@ -119,21 +464,102 @@ protected:
 	UObject* CreateNewObject(TSubclassOf<UObject> ObjectClass);
 
 	/**
-	 * 重置对象状态
+	 * 重置对象状态（借出时调用）
 	 * @param Object 要重置的对象
+	 * @param Poolable 对象的可池化接口，为nullptr时走通用逻辑
+	 * @param Handle 本次借出对应的句柄
+	 */
+	void ResetObject(UObject* Object, ISDTAPoolable* Poolable, const FSDTAPoolHandle& Handle);
+
+	/**
+	 * 停放对象（回收时调用）
+	 * @param Object 要停放的对象
+	 * @param Poolable 对象的可池化接口，为nullptr时只做通用处理
+	 */
+	void ParkObject(UObject* Object, ISDTAPoolable* Poolable);
+
+	/**
+	 * 查找或创建指定类的对象池
+	 * @return 对象池索引，失败返回INDEX_NONE
+	 */
+	int32 FindOrCreatePool(TSubclassOf<UObject> ObjectClass);
+
+	/**
+	 * 为新对象分配槽位（优先复用空槽位）并放入空闲链表
+	 * @return 分配的槽位索引
+	 */
+	int32 AddSlot(int32 PoolIndex, UObject* Object);
+
+	/**
+	 * 从指定对象池借出一个对象
+	 * @param PoolIndex 对象池索引
+	 * @param OutHandle 输出：对象句柄
+	 * @return 借出的对象，失败返回nullptr
+	 */
+	UObject* AcquireFromPool(int32 PoolIndex, FSDTAPoolHandle& OutHandle);
+
+	/**
+	 * 从空闲链表弹出一个槽位并标记为活跃，链表为空时创建新对象
+	 * 只做计数和统计，不重置对象
+	 * @return 槽位索引，达到最大大小或创建失败时返回INDEX_NONE
+	 */
+	int32 PopFreeSlot(int32 PoolIndex);
+
+	/**
+	 * 重置刚弹出的槽位中的对象并记录重置耗时
+	 * @param OutHandle 输出：对象句柄
+	 * @return 槽位中的对象
+	 */
+	UObject* FinishAcquire(int32 PoolIndex, int32 SlotIndex, FSDTAPoolHandle& OutHandle);
+
+	/**
+	 * 校验句柄后将槽位压回空闲链表，不停放对象
+	 * @return 句柄有效且对象处于活跃状态时返回true
+	 */
+	bool PushFreeSlot(const FSDTAPoolHandle& Handle);
+
+	/**
+	 * 查找对象当前代数的句柄，供按对象指针回收使用
+	 * 通过ISDTAPoolable保存的句柄直接定位槽位，并校验槽位中的对象就是该对象
+	 * @return 对象由对象池创建时返回true
+	 */
+	bool FindCurrentHandle(const UObject* Object, FSDTAPoolHandle& OutHandle) const;
+
+	/**
+	 * 销毁对象池中的全部对象，并使该池的索引失效
 	 */
-	void ResetObject(UObject* Object);
+	void DestroyPoolObjects(FPoolConfig& PoolConfig);
+
+	/**
+	 * 记录一次被拒绝的回收
+	 */
+	void RecordRejectedReturn(int32 PoolIndex, const UObject* Object);
+
+	/**
+	 * 当前世界是否允许池化指定类型
+	 * 客户端只允许不复制的类型，复制的Actor必须由服务器生成
+	 */
+	bool CanPoolClass(UClass* Class) const;
 
 protected:
 	/** 世界上下文 */
 	UPROPERTY()
 	UWorld* World;
 
-	/** 对象池映射，按对象类分类 */
-	TMap<UClass*, FPoolConfig> ObjectPools;
+	/** 对象池数组；索引一经分配不会复用，保证旧句柄不会指向新池 */
+	TArray<FPoolConfig> Pools;
 
-	/** 活跃对象到对象类的映射，用于快速查找对象所属的池 */
-	TMap<UObject*, UClass*> ActiveObjectToClassMap;
+	/** 对象类到对象池索引的映射，仅按类获取对象时使用 */
+	TMap<UClass*, int32> PoolIndexByClass;
+
+	/** 异步预热请求队列 */
+	TArray<FPrewarmRequest> PrewarmQueue;
+
+	/** 是否已安排下一帧处理预热队列 */
+	bool bPrewarmTickScheduled;
+
+	/** 维护定时器 */
+	FTimerHandle MaintenanceTimer;
 };
 
 // C++模板方法，用于更方便地使用对象池
@@ -155,6 +581,25 @@ T* SDTAGetPooledObject(USDTAPoolManager* PoolManager, TSubclassOf<T> ObjectClass
 	return Cast<T>(PoolManager->GetObject(ObjectClass));
 }
 
+/**
+ * 从对象池中获取指定类型的对象及其句柄（模板版本）
+ * @param PoolManager 对象池管理器
+ * @param ObjectClass 要获取的对象类
+ * @param OutHandle 输出：对象的池化句柄
+ * @return 获取到的对象，失败返回nullptr
+ */
+template<typename T>
+T* SDTAGetPooledObject(USDTAPoolManager* PoolManager, TSubclassOf<T> ObjectClass, FSDTAPoolHandle& OutHandle)
+{
+	OutHandle.Invalidate();
+	if (!PoolManager || !ObjectClass)
+	{
+		return nullptr;
+	}
+
+	return Cast<T>(PoolManager->GetObjectWithHandle(ObjectClass, OutHandle));
+}
+
 /**
  * 将对象回收回对象池（模板版本）
  * @param PoolManager 对象池管理器
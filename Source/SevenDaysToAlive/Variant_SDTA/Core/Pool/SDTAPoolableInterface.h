@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolManager.h"
+#include "SDTAPoolableInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class USDTAPoolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * 可池化对象接口，定义对象在借出和回收时的重置约定
+ *
+ * 设计要点：
+ * 1. 对象池按类缓存是否实现该接口，并在槽位中缓存接口指针，借出/回收时直接调用，无需类型转换
+ * 2. 每种对象只重置自己需要的状态，对象池不再包含具体类型的头文件
+ * 3. 未实现该接口的对象走对象池的通用逻辑（只恢复可见性、碰撞和Tick），且只能通过句柄回收
+ * 4. 纯C++接口，蓝图子类继承父类的实现
+ * 5. 接口保存对象在对象池中的句柄，按对象指针回收时直接定位槽位，对象池不维护对象到句柄的哈希表
+ */
+class SEVENDAYSTOALIVE_API ISDTAPoolable
+{
+	GENERATED_BODY()
+
+	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
+public:
+	/**
+	 * 从对象池借出时调用，将对象恢复到可用状态
+	 * 调用时对象仍处于回收时的位置，由调用方在借出后设置位置
+	 * @param Handle 本次借出对应的池化句柄，对象可保存用于之后通过句柄回收
+	 */
+	virtual void OnAcquiredFromPool(const FSDTAPoolHandle& Handle) {}
+
+	/**
+	 * 回收到对象池时调用，停止定时器、移动等仍在运行的逻辑
+	 * 隐藏、关闭碰撞和Tick由对象池统一处理
+	 */
+	virtual void OnReleasedToPool() {}
+
+	/**
+	 * 对象在对象池中的句柄
+	 * 由对象池在创建对象时和每次调用OnAcquiredFromPool之前写入；回收后保留槽位位置（代数已过期），
+	 * 不是由对象池创建的对象为无效句柄
+	 */
+	const FSDTAPoolHandle& GetPoolHandle() const { return PoolHandle; }
+
+private:
+	friend class USDTAPoolManager;
+
+	/** 对象在对象池中的句柄 */
+	FSDTAPoolHandle PoolHandle;
+};
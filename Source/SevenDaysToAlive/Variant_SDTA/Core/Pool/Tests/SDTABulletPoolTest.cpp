@@ -0,0 +1,193 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTABulletPoolTest.cpp - 子弹对象池自动化测试
+ *
+ * 实现细节：
+ * - 通过独立的GameInstance创建游戏世界，GameMode经世界设置生成为权威GameMode，武器开火时可以取到
+ * - GameMode带临时武器数据表，由BeginPlay调用PrewarmBulletPools；预热是分帧进行的，测试推进世界直到预热队列清空
+ * - 预热完成后由武器的FireProjectile连续开火数千次，每发子弹通过ReturnToPool回收，
+ *   断言对象池未命中次数、对象总数和世界中的Actor数量都不变
+ */
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Variant_SDTA/Core/Game/SDTAGameMode.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolManager.h"
+#include "Variant_SDTA/Core/Pool/Tests/SDTAPoolTestActors.h"
+#include "Variant_SDTA/Weapons/SDTAWeapon.h"
+#include "Variant_SDTA/Weapons/SDTAWeaponTypes.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "EngineUtils.h"
+
+namespace SDTABulletPoolTest
+{
+	/** 预热数量 */
+	static constexpr int32 PrewarmSize = 16;
+
+	/** 预热完成后开火的发数 */
+	static constexpr int32 RoundCount = 5000;
+
+	/** 等待预热的最大帧数 */
+	static constexpr int32 MaxPrewarmFrames = 600;
+
+	/** 统计世界中的Actor数量 */
+	static int32 CountActors(UWorld* World)
+	{
+		int32 Count = 0;
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			++Count;
+		}
+		return Count;
+	}
+
+	/** 测试武器使用的实体子弹武器数据 */
+	static FSDTAWeaponTableRow MakeWeaponRow()
+	{
+		FSDTAWeaponTableRow Row;
+		Row.BulletType = ESDTABulletType::Projectile;
+		Row.BulletClass = ASDTATestBullet::StaticClass();
+		return Row;
+	}
+
+	/** 创建只包含测试武器的临时数据表 */
+	static UDataTable* CreateWeaponTable()
+	{
+		UDataTable* Table = NewObject<UDataTable>(GetTransientPackage());
+		Table->RowStruct = FSDTAWeaponTableRow::StaticStruct();
+		Table->AddRow(FName("TestRifle"), MakeWeaponRow());
+
+		return Table;
+	}
+
+	/** 回收世界中所有已借出（可见）的测试子弹，模拟命中后回到对象池 */
+	static int32 ReturnActiveBullets(UWorld* World)
+	{
+		int32 Count = 0;
+		for (TActorIterator<ASDTATestBullet> It(World); It; ++It)
+		{
+			if (!It->IsHidden())
+			{
+				It->ReturnToPool();
+				++Count;
+			}
+		}
+		return Count;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSDTABulletPoolZeroAllocationTest, "SDTA.Pool.BulletPoolZeroAllocation",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * 预热后开火不再构造子弹Actor
+ *
+ * 功能：预热完成后通过武器开火并回收数千发子弹，对象池不产生未命中，对象总数和世界中的Actor数量不变
+ */
+bool FSDTABulletPoolZeroAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace SDTABulletPoolTest;
+
+	// 创建带GameInstance的游戏世界（对象池子系统只在Game/PIE世界中创建，SetGameMode需要GameInstance）
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	UWorld* World = GameInstance->GetWorld();
+	if (!TestNotNull(TEXT("创建游戏世界"), World))
+	{
+		GameInstance->RemoveFromRoot();
+		return false;
+	}
+
+	// 生成权威GameMode，BeginPlay中按武器数据表预热子弹对象池
+	World->GetWorldSettings()->DefaultGameMode = ASDTAGameMode::StaticClass();
+	World->SetGameMode(FURL());
+
+	ASDTAGameMode* GameMode = World->GetAuthGameMode<ASDTAGameMode>();
+	if (TestNotNull(TEXT("生成GameMode"), GameMode))
+	{
+		GameMode->WeaponDataTable = CreateWeaponTable();
+		GameMode->BulletPoolPrewarmSize = PrewarmSize;
+	}
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// 生成武器持有者和武器，武器的所有者为持有者
+	ASDTATestWeaponHolder* Holder = World->SpawnActor<ASDTATestWeaponHolder>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+
+	FActorSpawnParameters WeaponSpawnParams;
+	WeaponSpawnParams.Owner = Holder;
+	ASDTAWeapon* Weapon = World->SpawnActor<ASDTAWeapon>(ASDTAWeapon::StaticClass(), FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator, WeaponSpawnParams);
+	if (Holder && Weapon)
+	{
+		Weapon->SetWeaponOwner(TScriptInterface<ISDTAWeaponHolder>(Holder));
+		Weapon->SetWeaponDataRow(MakeWeaponRow());
+	}
+
+	USDTAPoolManager* PoolManager = USDTAPoolManager::Get(World);
+	const TSubclassOf<ASDTABullet> BulletClass = ASDTATestBullet::StaticClass();
+
+	if (GameMode && TestNotNull(TEXT("生成武器"), Weapon) && TestNotNull(TEXT("获取对象池管理器"), PoolManager))
+	{
+		// 推进世界直到分帧预热完成
+		for (int32 Frame = 0; Frame < MaxPrewarmFrames && PoolManager->IsPrewarming(); ++Frame)
+		{
+			World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+		}
+
+		TestFalse(TEXT("预热在限定帧数内完成"), PoolManager->IsPrewarming());
+		TestTrue(TEXT("子弹对象池已创建"), PoolManager->HasPool(BulletClass));
+
+		int32 PooledCount = 0;
+		int32 ActiveCount = 0;
+		PoolManager->GetPoolInfo(BulletClass, PooledCount, ActiveCount);
+		TestTrue(TEXT("子弹对象池已预热"), PooledCount >= PrewarmSize);
+
+		FSDTAPoolStats StatsBefore;
+		PoolManager->GetPoolStats(BulletClass, StatsBefore);
+		const int32 ObjectsBefore = PooledCount + ActiveCount;
+		const int32 ActorsBefore = CountActors(World);
+
+		// 连续开火：每发子弹由武器借出并激活后立即回收，模拟命中后回到对象池
+		int32 FailedShots = 0;
+		for (int32 Round = 0; Round < RoundCount; ++Round)
+		{
+			Weapon->FireProjectile();
+			if (ReturnActiveBullets(World) != 1)
+			{
+				++FailedShots;
+			}
+		}
+
+		FSDTAPoolStats StatsAfter;
+		PoolManager->GetPoolStats(BulletClass, StatsAfter);
+		PoolManager->GetPoolInfo(BulletClass, PooledCount, ActiveCount);
+
+		TestEqual(TEXT("每次开火借出并回收一发子弹"), FailedShots, 0);
+		TestEqual(TEXT("借出次数"), StatsAfter.Acquisitions - StatsBefore.Acquisitions, RoundCount);
+		TestEqual(TEXT("回收次数"), StatsAfter.Returns - StatsBefore.Returns, RoundCount);
+		TestEqual(TEXT("预热后未命中次数不增加"), StatsAfter.Misses, StatsBefore.Misses);
+		TestEqual(TEXT("对象池的对象总数不变"), PooledCount + ActiveCount, ObjectsBefore);
+		TestEqual(TEXT("没有借出未回收的子弹"), ActiveCount, 0);
+		TestEqual(TEXT("世界中的Actor数量不变"), CountActors(World), ActorsBefore);
+	}
+
+	// 清理世界
+	GameInstance->Shutdown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
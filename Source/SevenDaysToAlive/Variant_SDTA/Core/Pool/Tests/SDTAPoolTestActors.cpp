@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAPoolTestActors.cpp - 对象池测试用Actor
+ *
+ * 实现细节：
+ * - 持有者只需要一个根组件确定位置，瞄准点取前方固定距离
+ */
+
+#include "Variant_SDTA/Core/Pool/Tests/SDTAPoolTestActors.h"
+#include "Components/SceneComponent.h"
+
+ASDTATestWeaponHolder::ASDTATestWeaponHolder()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+/**
+ * 获取武器瞄准目标位置
+ *
+ * @return 持有者前方1000cm处
+ */
+FVector ASDTATestWeaponHolder::GetWeaponTargetLocation_Implementation()
+{
+	return GetActorLocation() + GetActorForwardVector() * 1000.0f;
+}
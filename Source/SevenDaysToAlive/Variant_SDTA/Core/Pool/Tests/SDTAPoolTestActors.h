@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Variant_SDTA/Weapons/SDTABullet.h"
+#include "Variant_SDTA/Weapons/SDTAWeaponHolderInterface.h"
+#include "SDTAPoolTestActors.generated.h"
+
+/**
+ * 对象池测试用子弹
+ *
+ * 功能：ASDTABullet是抽象类，测试需要一个可以生成的具体子弹类
+ * 设计要点：不添加任何行为，借出、激活和回收完全走ASDTABullet的逻辑
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class SEVENDAYSTOALIVE_API ASDTATestBullet : public ASDTABullet
+{
+	GENERATED_BODY()
+};
+
+/**
+ * 对象池测试用武器持有者
+ *
+ * 功能：为ASDTAWeapon::FireProjectile提供瞄准位置，其余回调为空实现
+ * 设计要点：瞄准点固定在持有者前方，子弹方向与枪口位置无关
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class SEVENDAYSTOALIVE_API ASDTATestWeaponHolder : public AActor, public ISDTAWeaponHolder
+{
+	GENERATED_BODY()
+
+public:
+	ASDTATestWeaponHolder();
+
+	// ISDTAWeaponHolder接口
+	virtual void AttachWeaponMeshes_Implementation(ASDTAWeapon* Weapon) override {}
+	virtual void PlayFiringMontage_Implementation(UAnimMontage* Montage) override {}
+	virtual void AddWeaponRecoil_Implementation(float RecoilAmount) override {}
+	virtual void UpdateWeaponHUD_Implementation(int32 CurrentAmmo, int32 MaxAmmo) override {}
+	virtual FVector GetWeaponTargetLocation_Implementation() override;
+	virtual void AddWeaponClass_Implementation(TSubclassOf<ASDTAWeapon> WeaponClass) override {}
+	virtual void OnWeaponActivated_Implementation(ASDTAWeapon* Weapon) override {}
+	virtual void OnWeaponDeactivated_Implementation(ASDTAWeapon* Weapon) override {}
+};
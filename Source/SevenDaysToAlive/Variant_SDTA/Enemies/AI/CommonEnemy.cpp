@@ -1,16 +1,18 @@
 // 七日求生普通敌人类实现
 
 #include "Variant_SDTA/Enemies/AI/CommonEnemy.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyManager.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyTrace.h"
 #include "Variant_SDTA/Characters/SDTAPlayerBase.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "NavigationSystem.h"
 #include "NavigationPath.h"
 #include "AIController.h"
 
 ACommonEnemy::ACommonEnemy()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// AI由USDTAEnemyManager集中更新，敌人自身不再Tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// 设置AI控制器类
 	AIControllerClass = AAIController::StaticClass();
@@ -27,6 +29,7 @@ ACommonEnemy::ACommonEnemy()
 
 	bCanAttack = true;
 	PlayerRef = nullptr;
+	AIManagerIndex = INDEX_NONE;
 	
 	// 确保CharacterMovement组件可用
 	if (GetCharacterMovement())
@@ -43,68 +46,66 @@ void ACommonEnemy::BeginPlay()
 	if (GetCharacterMovement())
 	{
 		GetCharacterMovement()->MaxWalkSpeed = 300.0f;
-		UE_LOG(LogTemp, Log, TEXT("[敌人] 初始化: 移动速度设置为 300"));
 	}
 
-	// 获取玩家引用
-	PlayerRef = GetPlayerCharacter();
-	UE_LOG(LogTemp, Log, TEXT("[敌人] 初始化: 玩家引用获取 %s"), PlayerRef ? TEXT("成功") : TEXT("失败"));
-	UE_LOG(LogTemp, Log, TEXT("[敌人] 初始化完成: ID=%d, 位置=%s"), GetUniqueID(), *GetActorLocation().ToString());
+	// 目标玩家由USDTAEnemyManager按节奏分配，这里不再查询0号玩家
+	UE_LOG(LogSDTAEnemy, Verbose, TEXT("[敌人] 初始化完成: ID=%u"), GetUniqueID());
+	SDTA_ENEMY_TRACE(this, Spawned);
+
+	// 注册到敌人AI更新管理器（AI只在服务器上运行）
+	if (HasAuthority())
+	{
+		if (USDTAEnemyManager* EnemyManager = USDTAEnemyManager::Get(this))
+		{
+			EnemyManager->RegisterEnemy(this);
+		}
+	}
 }
 
-void ACommonEnemy::Tick(float DeltaTime)
+void ACommonEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-
-	// 检测是否正在移动
-	UCharacterMovementComponent* Movement = GetCharacterMovement();
-	if (Movement)
+	if (USDTAEnemyManager* EnemyManager = USDTAEnemyManager::Get(this))
 	{
-		IsMoving = Movement->Velocity.Size2D() > 1.0f;
+		EnemyManager->UnregisterEnemy(this);
 	}
 
-	// 每帧更新玩家引用
-	if (!PlayerRef)
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACommonEnemy::OnAcquiredFromPool(const FSDTAPoolHandle& Handle)
+{
+	Super::OnAcquiredFromPool(Handle);
+	SDTA_ENEMY_TRACE(this, Spawned);
+
+	if (HasAuthority())
 	{
-		PlayerRef = GetPlayerCharacter();
-		if (PlayerRef)
+		if (USDTAEnemyManager* EnemyManager = USDTAEnemyManager::Get(this))
 		{
-			UE_LOG(LogTemp, Log, TEXT("[敌人] 状态变化: ID=%d 玩家引用获取成功，位置=%s"), GetUniqueID(), *PlayerRef->GetActorLocation().ToString());
+			EnemyManager->RegisterEnemy(this);
 		}
 	}
+}
+
+void ACommonEnemy::OnReleasedToPool()
+{
+	Super::OnReleasedToPool();
+	SDTA_ENEMY_TRACE(this, Released);
 
-	// AI行为逻辑：直接追逐攻击玩家，不再巡逻
-	if (PlayerRef && !bIsDead)
+	if (USDTAEnemyManager* EnemyManager = USDTAEnemyManager::Get(this))
 	{
-		// 检查是否在攻击范围内
-		if (IsPlayerInRange(AttackRange))
-		{
-			// 攻击玩家
-			UE_LOG(LogTemp, Log, TEXT("[敌人] 状态变化: ID=%d 进入攻击范围，距离玩家=%.1fcm"), GetUniqueID(), FVector::Dist(GetActorLocation(), PlayerRef->GetActorLocation()));
-			AttackPlayer();
-		}
-		else if (IsPlayerInRange(ChaseRange))
-		{
-			// 追逐玩家
-			UE_LOG(LogTemp, Log, TEXT("[敌人] 状态变化: ID=%d 进入追逐范围，距离玩家=%.1fcm"), GetUniqueID(), FVector::Dist(GetActorLocation(), PlayerRef->GetActorLocation()));
-			ChasePlayer();
-		}
-		else
-		{
-			UE_LOG(LogTemp, Log, TEXT("[敌人] 状态变化: ID=%d 玩家超出范围，距离玩家=%.1fcm"), GetUniqueID(), FVector::Dist(GetActorLocation(), PlayerRef->GetActorLocation()));
-		}
+		EnemyManager->UnregisterEnemy(this);
 	}
+
+	ClearEnemyTimer(ESDTAEnemyTimer::AttackCooldown);
+	bCanAttack = true;
+	IsAttacking = false;
+	PlayerRef = nullptr;
 }
 
 ASDTAPlayerBase* ACommonEnemy::GetPlayerCharacter()
 {
-	// 获取玩家角色
-	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
-	if (PlayerPawn)
-	{
-		return Cast<ASDTAPlayerBase>(PlayerPawn);
-	}
-	return nullptr;
+	// 返回敌人AI更新管理器分配的目标玩家
+	return PlayerRef;
 }
 
 bool ACommonEnemy::IsPlayerInRange(float Range)
@@ -114,16 +115,15 @@ bool ACommonEnemy::IsPlayerInRange(float Range)
 		return false;
 	}
 
-	// 计算与玩家的距离
-	float Distance = FVector::Dist(GetActorLocation(), PlayerRef->GetActorLocation());
-	return Distance <= Range;
+	// 比较距离平方，避免开方
+	return FVector::DistSquared(GetActorLocation(), PlayerRef->GetActorLocation()) <= FMath::Square(Range);
 }
 
 void ACommonEnemy::ChasePlayer()
 {
 	if (!PlayerRef || bIsDead)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[敌人] 追逐失败: ID=%d 玩家引用无效或已死亡"), GetUniqueID());
+		SDTA_ENEMY_TRACE(this, ChaseFailed);
 		return;
 	}
 
@@ -133,14 +133,12 @@ void ACommonEnemy::ChasePlayer()
 	{
 		// 使用AI Move To让敌人移动到玩家位置
 		AIController->MoveToLocation(PlayerRef->GetActorLocation(), -1.0f, true, true, false, true, 0, true);
-		UE_LOG(LogTemp, Log, TEXT("[敌人] 追逐: ID=%d 使用AI控制器追逐玩家，目标位置=%s"), GetUniqueID(), *PlayerRef->GetActorLocation().ToString());
 	}
 	else
 	{
 		// 直接调用Character的AddMovementInput方法
 		FVector Direction = (PlayerRef->GetActorLocation() - GetActorLocation()).GetSafeNormal2D();
 		AddMovementInput(Direction);
-		UE_LOG(LogTemp, Log, TEXT("[敌人] 追逐: ID=%d 直接移动追逐玩家，方向=%s"), GetUniqueID(), *Direction.ToString());
 	}
 }
 
@@ -148,14 +146,18 @@ void ACommonEnemy::AttackPlayer()
 {
 	if (!PlayerRef || bIsDead || !bCanAttack)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[敌人] 攻击失败: ID=%d 条件不满足 (玩家=%s, 存活=%d, 可攻击=%d)"), GetUniqueID(), PlayerRef ? TEXT("有效") : TEXT("无效"), !bIsDead, bCanAttack);
+		// 冷却中每次AI更新都会走到这里，只在缺少目标或已死亡时记录
+		if (!PlayerRef || bIsDead)
+		{
+			SDTA_ENEMY_TRACE(this, AttackFailed);
+		}
 		return;
 	}
 
 	// 执行攻击
 	IsAttacking = true;
 	Attack();
-	UE_LOG(LogTemp, Log, TEXT("[敌人] 攻击: ID=%d 向玩家发起攻击"), GetUniqueID());
+	SDTA_ENEMY_TRACE(this, Attack, AttackCooldown);
 
 	// 设置攻击冷却
 	SetAttackCooldown();
@@ -164,24 +166,25 @@ void ACommonEnemy::AttackPlayer()
 void ACommonEnemy::SetAttackCooldown()
 {
 	bCanAttack = false;
-	UE_LOG(LogTemp, Log, TEXT("[敌人] 攻击冷却: ID=%d 开始冷却，持续时间=%.1f秒"), GetUniqueID(), AttackCooldown);
 
-	// 设置定时器
-	if (GetWorld())
+	// 冷却由敌人AI更新管理器的时间轮统一计时
+	StartEnemyTimer(ESDTAEnemyTimer::AttackCooldown, AttackCooldown);
+}
+
+void ACommonEnemy::OnEnemyTimerFired(ESDTAEnemyTimer Timer)
+{
+	if (Timer == ESDTAEnemyTimer::AttackCooldown)
 	{
-		GetWorld()->GetTimerManager().SetTimer(
-			AttackCooldownTimer,
-			this,
-			&ACommonEnemy::OnAttackCooldownFinished,
-			AttackCooldown,
-			false
-		);
+		OnAttackCooldownFinished();
+		return;
 	}
+
+	Super::OnEnemyTimerFired(Timer);
 }
 
 void ACommonEnemy::OnAttackCooldownFinished()
 {
 	bCanAttack = true;
 	IsAttacking = false;
-	UE_LOG(LogTemp, Log, TEXT("[敌人] 攻击冷却: ID=%d 冷却结束，可再次攻击"), GetUniqueID());
+	SDTA_ENEMY_TRACE(this, AttackReady);
 }
@@ -10,6 +10,7 @@
 /**
  * 普通敌人类，实现通用的AI行为逻辑
  * 具体敌人类型（如僵尸、感染者等）可以继承此类或直接创建蓝图
+ * AI不再由每个敌人自己的Tick驱动，而是由USDTAEnemyManager集中批量更新
  */
 UCLASS()
 class SEVENDAYSTOALIVE_API ACommonEnemy : public AEnemyBase
@@ -21,7 +22,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// 敌人AI行为配置
@@ -45,15 +46,32 @@ public:
 	virtual void ChasePlayer() override;
 	virtual void AttackPlayer() override;
 
-	// 获取玩家角色
+	// 获取当前目标玩家（由敌人AI更新管理器分配，可能为空）
 	class ASDTAPlayerBase* GetPlayerCharacter();
 
 	// 检查玩家是否在范围内
 	bool IsPlayerInRange(float Range);
 
+	// 设置追逐/攻击的目标玩家（由敌人AI更新管理器按目标选择结果设置）
+	void SetTargetPlayer(class ASDTAPlayerBase* InPlayer) { PlayerRef = InPlayer; }
+
+	/** ISDTAPoolable：借出时注册到敌人AI更新管理器 */
+	virtual void OnAcquiredFromPool(const FSDTAPoolHandle& Handle) override;
+
+	/** ISDTAPoolable：回收时从敌人AI更新管理器注销 */
+	virtual void OnReleasedToPool() override;
+
+protected:
+	/** 处理攻击冷却定时器，其余类型交给基类 */
+	virtual void OnEnemyTimerFired(ESDTAEnemyTimer Timer) override;
+
 private:
+	friend class USDTAEnemyManager;
+
+	// 在敌人AI更新管理器中的下标，未注册时为INDEX_NONE
+	int32 AIManagerIndex;
+
 	// 内部状态
-	FTimerHandle AttackCooldownTimer;
 	bool bCanAttack;
 
 	// 玩家引用
@@ -23,13 +23,11 @@
 #include "Variant_SDTA/Enemies/AI/EnemyBase.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
 
-// 前向声明
-class ASDTAGameMode;
-
-// 包含对象池管理器和游戏模式头文件
+// 包含对象池管理器头文件
 #include "Variant_SDTA/Core/Pool/SDTAPoolManager.h"
-#include "Variant_SDTA/Core/Game/SDTAGameMode.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyManager.h"
 
 /**
  * 构造函数
@@ -153,7 +151,7 @@ float AEnemyBase::TakeDamage(float DamageAmount, struct FDamageEvent const& Dama
  * 设计要点：
  * 1. 只有在敌人未死亡时才应用伤害
  * 2. 减少敌人的生命值并触发受击反馈事件
- * 3. 播放受击动画并设置定时器监听动画完成
+ * 3. 播放受击动画并通过时间轮定时器监听动画完成
  * 4. 当生命值降至0或以下时触发死亡逻辑
  * 
  * @param DamageAmount 要应用的伤害量
@@ -175,7 +173,7 @@ void AEnemyBase::ApplyDamage(float DamageAmount, const FHitResult& HitResult)
 		bIsHit = true;
 		float MontageLength = HitMontage->GetPlayLength();
 		GetMesh()->GetAnimInstance()->Montage_Play(HitMontage);
-		GetWorld()->GetTimerManager().SetTimer(HitAnimationTimer, this, &AEnemyBase::OnHitAnimationFinished, MontageLength, false);
+		StartEnemyTimer(ESDTAEnemyTimer::HitAnimation, MontageLength);
 	}
 
 	if (Health <= 0.0f)
@@ -209,7 +207,7 @@ void AEnemyBase::Attack()
  * 1. 设置死亡状态标志
  * 2. 禁用敌人的碰撞和移动
  * 3. 清理受击动画定时器
- * 4. 播放死亡动画并设置定时器监听动画完成
+ * 4. 播放死亡动画并通过时间轮定时器监听动画完成
  * 5. 如果没有死亡动画，则直接调用死亡动画完成回调
  * 
  * 注意：死亡动画播放完成后会触发OnDeathAnimationFinished方法进行后续处理
@@ -223,17 +221,14 @@ void AEnemyBase::Die()
 	GetCharacterMovement()->DisableMovement();
 
 	// 取消受击动画定时器（如果有）
-	if (GetWorld()->GetTimerManager().IsTimerActive(HitAnimationTimer))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(HitAnimationTimer);
-	}
+	ClearEnemyTimer(ESDTAEnemyTimer::HitAnimation);
 
 	// 播放死亡动画蒙太奇
 	if (DeathMontage)
 	{
 		float MontageLength = DeathMontage->GetPlayLength();
 		GetMesh()->GetAnimInstance()->Montage_Play(DeathMontage);
-		GetWorld()->GetTimerManager().SetTimer(DeathAnimationTimer, this, &AEnemyBase::OnDeathAnimationFinished, MontageLength, false);
+		StartEnemyTimer(ESDTAEnemyTimer::DeathAnimation, MontageLength);
 	}
 	else
 	{
@@ -251,25 +246,26 @@ void AEnemyBase::Die()
  * 设计要点：
  * 1. 触发蓝图实现的死亡动画完成事件
  * 2. 获取对象池管理器并尝试将敌人回收回对象池
- * 3. 如果对象池管理器不存在，则直接销毁敌人对象
+ * 3. 如果对象池管理器不存在或敌人并非由对象池创建，则直接销毁敌人对象
+ * 4. 由对象池创建但回收被拒绝（重复回收）时不销毁，避免池中留下已销毁的对象
  * 
- * 注意：该方法通过FTimerManager在死亡动画播放完成后自动调用
+ * 注意：该方法由敌人定时器在死亡动画播放完成后调用
  */
 void AEnemyBase::OnDeathAnimationFinished()
 {
 	// 死亡动画播放完成后的逻辑
 	BP_OnDeathAnimationFinished();
 	
-	// 获取对象池管理器
+	// 获取对象池管理器，将敌人对象回收回对象池
 	USDTAPoolManager* PoolManager = GetPoolManager();
-	if (PoolManager)
+	if (PoolManager && PoolManager->ReturnObject(this))
 	{
-		// 将敌人对象回收回对象池
-		PoolManager->ReturnObject(this);
+		return;
 	}
-	else
+
+	if (!PoolManager || !PoolManager->OwnsObject(this))
 	{
-		// 如果对象池管理器不存在，直接销毁敌人
+		// 如果对象池管理器不存在或敌人不属于对象池，直接销毁敌人
 		Destroy();
 	}
 }
@@ -282,7 +278,7 @@ void AEnemyBase::OnDeathAnimationFinished()
  * 1. 重置受击状态标志，允许敌人再次播放受击动画
  * 2. 触发蓝图实现的受击动画完成事件
  * 
- * 注意：该方法通过FTimerManager在受击动画播放完成后自动调用
+ * 注意：该方法由敌人定时器在受击动画播放完成后调用
  */
 void AEnemyBase::OnHitAnimationFinished()
 {
@@ -379,14 +375,8 @@ void AEnemyBase::Reset()
 	}
 
 	// 清除所有定时器
-	if (GetWorld() && GetWorld()->GetTimerManager().IsTimerActive(DeathAnimationTimer))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(DeathAnimationTimer);
-	}
-	if (GetWorld() && GetWorld()->GetTimerManager().IsTimerActive(HitAnimationTimer))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(HitAnimationTimer);
-	}
+	ClearEnemyTimer(ESDTAEnemyTimer::DeathAnimation);
+	ClearEnemyTimer(ESDTAEnemyTimer::HitAnimation);
 
 	// 重置敌人位置（可选，可以在获取对象时由对象池管理器设置）
 	// SetActorLocation(FVector::ZeroVector);
@@ -394,31 +384,100 @@ void AEnemyBase::Reset()
 }
 
 /**
- * 获取对象池管理器实例
+ * 从对象池借出回调
  * 
- * 功能：安全获取游戏模式中的对象池管理器实例
- * 设计要点：
- * 1. 进行安全检查，确保世界和游戏模式有效
- * 2. 通过游戏模式的公共GetPoolManager方法获取对象池管理器
- * 3. 提供安全的接口，避免直接访问私有成员
+ * 功能：实现ISDTAPoolable，在对象池借出敌人时重置其状态
+ * 设计要点：位置由GameMode在借出后设置，这里只恢复生命值、状态和移动
  * 
- * @return 对象池管理器实例，如果不存在则返回nullptr
+ * @param Handle 本次借出对应的池化句柄
  */
-USDTAPoolManager* AEnemyBase::GetPoolManager() const
+void AEnemyBase::OnAcquiredFromPool(const FSDTAPoolHandle& Handle)
 {
-	if (!GetWorld())
+	Reset();
+}
+
+/**
+ * 回收到对象池回调
+ * 
+ * 功能：实现ISDTAPoolable，在敌人回收时停止仍在运行的逻辑
+ * 设计要点：
+ * 1. 停止AI寻路，避免回收后控制器继续驱动移动
+ * 2. 清除死亡和受击动画定时器，避免回收后回调再次触发
+ */
+void AEnemyBase::OnReleasedToPool()
+{
+	if (AController* EnemyController = GetController())
 	{
-		return nullptr;
+		EnemyController->StopMovement();
 	}
 
-	// 获取游戏模式
-	ASDTAGameMode* GameMode = Cast<ASDTAGameMode>(GetWorld()->GetAuthGameMode());
-	if (!GameMode)
+	GetCharacterMovement()->StopMovementImmediately();
+
+	ClearEnemyTimer(ESDTAEnemyTimer::DeathAnimation);
+	ClearEnemyTimer(ESDTAEnemyTimer::HitAnimation);
+}
+
+/**
+ * 设置敌人定时器
+ *
+ * 功能：交给敌人AI更新管理器的时间轮统一计时
+ * 设计要点：管理器只存在于游戏世界中，其他世界（如编辑器预览）中立即触发回调
+ *
+ * @param Timer 定时器类型
+ * @param Delay 延迟（秒）
+ */
+void AEnemyBase::StartEnemyTimer(ESDTAEnemyTimer Timer, float Delay)
+{
+	if (USDTAEnemyManager* EnemyManager = USDTAEnemyManager::Get(this))
 	{
-		return nullptr;
+		EnemyManager->ScheduleEnemyTimer(this, Timer, Delay);
 	}
+	else
+	{
+		OnEnemyTimerFired(Timer);
+	}
+}
 
-	// 调用GameMode的公共GetPoolManager方法
-	return GameMode->GetPoolManager();
+/**
+ * 取消敌人定时器
+ *
+ * @param Timer 定时器类型
+ */
+void AEnemyBase::ClearEnemyTimer(ESDTAEnemyTimer Timer)
+{
+	FSDTAEnemyTimerWheel::Cancel(this, Timer);
+}
+
+/**
+ * 敌人定时器到期回调
+ *
+ * @param Timer 定时器类型
+ */
+void AEnemyBase::OnEnemyTimerFired(ESDTAEnemyTimer Timer)
+{
+	switch (Timer)
+	{
+	case ESDTAEnemyTimer::HitAnimation:
+		OnHitAnimationFinished();
+		break;
+	case ESDTAEnemyTimer::DeathAnimation:
+		OnDeathAnimationFinished();
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * 获取对象池管理器实例
+ * 
+ * 功能：获取敌人所在世界的对象池子系统
+ * 设计要点：对象池是世界子系统，直接按类获取，不再经过游戏模式的转换
+ * 
+ * @return 对象池管理器实例，如果不存在则返回nullptr
+ */
+USDTAPoolManager* AEnemyBase::GetPoolManager() const
+{
+	return USDTAPoolManager::Get(this);
 }
 
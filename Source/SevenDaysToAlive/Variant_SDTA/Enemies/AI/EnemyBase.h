@@ -11,7 +11,7 @@
  * 
  * 设计要点：
  * - 采用继承结构，支持多种敌人类型的扩展
- * - 使用UE5内置FTimerManager处理动画完成事件
+ * - 受击/死亡动画完成等定时事件由USDTAEnemyManager的时间轮统一处理，不再逐个向FTimerManager注册
  * - 提供蓝图可调用的方法，支持蓝图扩展
  * - 实现对象池兼容的Reset方法，支持敌人的高效复用
  * - 完善的事件系统，支持动画事件和状态变化通知
@@ -34,7 +34,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Animation/AnimMontage.h"
-#include "TimerManager.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolableInterface.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyRegistry.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyTimerWheel.h"
 
 // 前向声明
 class USDTAPoolManager;
@@ -45,7 +47,7 @@ class USDTAPoolManager;
  * 敌人基类，所有敌人类都继承自此
  */
 UCLASS()
-class SEVENDAYSTOALIVE_API AEnemyBase : public ACharacter
+class SEVENDAYSTOALIVE_API AEnemyBase : public ACharacter, public ISDTAPoolable
 {
 	GENERATED_BODY()
 
@@ -174,16 +176,39 @@ public:
 	 */
 	virtual void AttackPlayer();
 
+	/** 敌人是否已死亡 */
+	bool IsDead() const { return bIsDead; }
+
 protected:
 	// 内部状态
 	bool bIsDead; // 敌人是否已死亡
 	bool bIsAttacking; // 敌人是否正在攻击
 	bool bIsHit; // 是否正在播放受击动画
 
-	// 死亡动画定时器
-	FTimerHandle DeathAnimationTimer; // 用于监听死亡动画完成事件的定时器
-	// 受击动画定时器
-	FTimerHandle HitAnimationTimer; // 用于监听受击动画完成事件的定时器
+	/**
+	 * 设置敌人定时器（同类型的旧定时器被替换）
+	 *
+	 * 功能：交给敌人AI更新管理器的时间轮统一计时，到期后调用OnEnemyTimerFired
+	 *
+	 * @param Timer 定时器类型
+	 * @param Delay 延迟（秒）
+	 */
+	void StartEnemyTimer(ESDTAEnemyTimer Timer, float Delay);
+
+	/** 取消敌人定时器（未在计时时忽略） */
+	void ClearEnemyTimer(ESDTAEnemyTimer Timer);
+
+	/** 敌人定时器是否正在计时 */
+	bool IsEnemyTimerActive(ESDTAEnemyTimer Timer) const { return FSDTAEnemyTimerWheel::IsActive(this, Timer); }
+
+	/**
+	 * 敌人定时器到期回调
+	 *
+	 * 功能：分发受击和死亡动画完成事件，子类重写以处理自己的定时器类型
+	 *
+	 * @param Timer 定时器类型
+	 */
+	virtual void OnEnemyTimerFired(ESDTAEnemyTimer Timer);
 
 	/**
 	 * 死亡动画完成回调
@@ -226,6 +251,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Enemy|Pool")
 	virtual void Reset();
 
+	/** ISDTAPoolable：从对象池借出时重置敌人状态 */
+	virtual void OnAcquiredFromPool(const FSDTAPoolHandle& Handle) override;
+
+	/** ISDTAPoolable：回收到对象池时停止AI寻路和动画定时器 */
+	virtual void OnReleasedToPool() override;
+
+	/** 敌人注册表分配的句柄（注销后失效，再次生成时重新分配） */
+	const FSDTAEnemyHandle& GetRegistryHandle() const { return RegistryHandle; }
+
+	/** 由敌人注册表在注册时调用 */
+	void SetRegistryHandle(const FSDTAEnemyHandle& Handle) { RegistryHandle = Handle; }
+
 protected:
 	/**
 	 * 获取对象池管理器实例
@@ -233,4 +270,12 @@ protected:
 	 */
 	USDTAPoolManager* GetPoolManager() const;
 
+private:
+	friend class FSDTAEnemyTimerWheel;
+
+	/** 敌人注册表句柄 */
+	FSDTAEnemyHandle RegistryHandle;
+
+	/** 敌人定时器状态（由时间轮读写） */
+	FSDTAEnemyTimerState TimerState;
 };
@@ -0,0 +1,313 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAFlowField.cpp - 导航网格采样缓存和流场实现文件
+ *
+ * 实现细节：
+ * - 构建时先把流场范围内格子的可行走状态和高度读入连续数组，广度优先搜索只访问这些数组
+ * - 广度优先搜索只走四个正交方向，得到的步数再用于八方向的方向选择，斜向路线自然更短
+ * - 临时数组作为成员复用，重复构建不会重新分配内存
+ */
+
+#include "Variant_SDTA/Enemies/Navigation/SDTAFlowField.h"
+#include "NavigationSystem.h"
+#include "Engine/World.h"
+
+namespace SDTAFlowField
+{
+	/** 八个相邻格子的偏移，前四个为正交方向 */
+	static const FIntPoint NeighborOffsets[8] =
+	{
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+
+	/** 不可行走格子的高度标记 */
+	static constexpr float BlockedHeight = TNumericLimits<float>::Max();
+}
+
+#pragma region FSDTANavGrid
+
+/**
+ * 设置格子尺寸
+ *
+ * @param InCellSize 格子边长（cm）
+ */
+void FSDTANavGrid::Configure(float InCellSize)
+{
+	const float NewCellSize = FMath::Max(InCellSize, 10.0f);
+	if (!FMath::IsNearlyEqual(NewCellSize, CellSize))
+	{
+		Cells.Reset();
+	}
+
+	CellSize = NewCellSize;
+}
+
+/**
+ * 查找格子，尚未采样且预算允许时立即投影采样
+ *
+ * @param World 游戏世界
+ * @param Cell 格子坐标
+ * @param ReferenceZ 投影的参考高度
+ * @param InOutProbeBudget 输入输出：本帧剩余的采样次数
+ * @return 已采样时返回格子，否则返回nullptr
+ */
+const FSDTANavGrid::FCell* FSDTANavGrid::FindOrProbe(UWorld* World, const FIntPoint& Cell, float ReferenceZ, int32& InOutProbeBudget)
+{
+	if (const FCell* Cached = Cells.Find(Cell))
+	{
+		return Cached;
+	}
+
+	if (InOutProbeBudget <= 0)
+	{
+		return nullptr;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+	{
+		return nullptr;
+	}
+
+	InOutProbeBudget--;
+
+	FVector SamplePoint = CellToWorld(Cell);
+	SamplePoint.Z = ReferenceZ;
+
+	const FVector QueryExtent(CellSize * 0.5f, CellSize * 0.5f, ProbeHalfHeight);
+	FNavLocation NavLocation;
+
+	FCell& NewCell = Cells.Add(Cell);
+	NewCell.bWalkable = NavSys->ProjectPointToNavigation(SamplePoint, NavLocation, QueryExtent);
+	NewCell.Height = NewCell.bWalkable ? NavLocation.Location.Z : ReferenceZ;
+	return &NewCell;
+}
+
+/**
+ * 丢弃远离所有保留中心的格子
+ *
+ * 功能：玩家长时间移动后，缓存中会累积大量不再被任何流场覆盖的格子，只保留各中心附近的格子
+ *
+ * @param KeepCenters 保留中心的格子坐标
+ * @param KeepRadiusCells 保留半径（格子数）
+ * @return 丢弃的格子数量
+ */
+int32 FSDTANavGrid::EvictFarCells(TConstArrayView<FIntPoint> KeepCenters, int32 KeepRadiusCells)
+{
+	const int32 NumBefore = Cells.Num();
+
+	for (TMap<FIntPoint, FCell>::TIterator It = Cells.CreateIterator(); It; ++It)
+	{
+		const FIntPoint& Cell = It.Key();
+		bool bNearCenter = false;
+		for (const FIntPoint& Center : KeepCenters)
+		{
+			if (FMath::Abs(Cell.X - Center.X) <= KeepRadiusCells && FMath::Abs(Cell.Y - Center.Y) <= KeepRadiusCells)
+			{
+				bNearCenter = true;
+				break;
+			}
+		}
+
+		if (!bNearCenter)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return NumBefore - Cells.Num();
+}
+
+FIntPoint FSDTANavGrid::WorldToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+FVector FSDTANavGrid::CellToWorld(const FIntPoint& Cell) const
+{
+	return FVector((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, 0.0f);
+}
+
+#pragma endregion
+
+#pragma region FSDTAFlowField
+
+/**
+ * 构建流场
+ *
+ * 功能：读取范围内格子的采样结果，从目标格子向外广度优先搜索，再为每个格子选择步数最小的相邻格子
+ *
+ * @param World 游戏世界
+ * @param NavGrid 导航网格采样缓存
+ * @param GoalLocation 目标位置
+ * @param RadiusCells 流场半径（格子数）
+ * @param MaxStepHeight 相邻格子间允许的最大高度差（cm）
+ * @param InOutProbeBudget 输入输出：本帧剩余的导航网格采样次数
+ * @param bOutComplete 输出：范围内的格子是否都已采样（采样预算用完时为false，需要之后重建）
+ * @return 目标所在格子可行走时返回true
+ */
+bool FSDTAFlowField::Build(UWorld* World, FSDTANavGrid& NavGrid, const FVector& GoalLocation, int32 RadiusCells, float MaxStepHeight, int32& InOutProbeBudget, bool& bOutComplete)
+{
+	using namespace SDTAFlowField;
+
+	RadiusCells = FMath::Max(RadiusCells, 1);
+	GoalCell = NavGrid.WorldToCell(GoalLocation);
+	Origin = GoalCell - FIntPoint(RadiusCells, RadiusCells);
+	Size = RadiusCells * 2 + 1;
+
+	const int32 NumCells = Size * Size;
+	Directions.Init(NoDirection, NumCells);
+	Heights.SetNumUninitialized(NumCells, EAllowShrinking::No);
+	Steps.Init(INDEX_NONE, NumCells);
+
+	// 读取采样结果，不可行走和尚未采样的格子高度记为BlockedHeight
+	const float ReferenceZ = GoalLocation.Z;
+	bOutComplete = true;
+	for (int32 Y = 0; Y < Size; ++Y)
+	{
+		for (int32 X = 0; X < Size; ++X)
+		{
+			const FSDTANavGrid::FCell* Cell = NavGrid.FindOrProbe(World, Origin + FIntPoint(X, Y), ReferenceZ, InOutProbeBudget);
+			Heights[Y * Size + X] = (Cell && Cell->bWalkable) ? Cell->Height : BlockedHeight;
+			bOutComplete &= (Cell != nullptr);
+		}
+	}
+
+	const int32 GoalIndex = ToLocalIndex(GoalCell);
+	if (Heights[GoalIndex] == BlockedHeight)
+	{
+		return false;
+	}
+
+	auto IsConnected = [this, MaxStepHeight](int32 FromIndex, int32 ToIndex)
+	{
+		const float ToHeight = Heights[ToIndex];
+		return ToHeight != BlockedHeight && FMath::Abs(ToHeight - Heights[FromIndex]) <= MaxStepHeight;
+	};
+
+	// 从目标向外广度优先搜索（四方向）
+	Frontier.Reset();
+	Frontier.Add(GoalIndex);
+	Steps[GoalIndex] = 0;
+
+	for (int32 Head = 0; Head < Frontier.Num(); ++Head)
+	{
+		const int32 Index = Frontier[Head];
+		const FIntPoint Local(Index % Size, Index / Size);
+
+		for (int32 Dir = 0; Dir < 4; ++Dir)
+		{
+			const FIntPoint Next = Local + NeighborOffsets[Dir];
+			if (Next.X < 0 || Next.Y < 0 || Next.X >= Size || Next.Y >= Size)
+			{
+				continue;
+			}
+
+			const int32 NextIndex = Next.Y * Size + Next.X;
+			if (Steps[NextIndex] == INDEX_NONE && IsConnected(Index, NextIndex))
+			{
+				Steps[NextIndex] = Steps[Index] + 1;
+				Frontier.Add(NextIndex);
+			}
+		}
+	}
+
+	// 每个已到达的格子指向步数最小的相邻格子（八方向）
+	for (int32 Index : Frontier)
+	{
+		if (Index == GoalIndex)
+		{
+			continue;
+		}
+
+		const FIntPoint Local(Index % Size, Index / Size);
+		int32 BestSteps = Steps[Index];
+		uint8 BestDir = NoDirection;
+
+		for (int32 Dir = 0; Dir < 8; ++Dir)
+		{
+			const FIntPoint Offset = NeighborOffsets[Dir];
+			const FIntPoint Next = Local + Offset;
+			if (Next.X < 0 || Next.Y < 0 || Next.X >= Size || Next.Y >= Size)
+			{
+				continue;
+			}
+
+			const int32 NextIndex = Next.Y * Size + Next.X;
+			if (Steps[NextIndex] == INDEX_NONE || Steps[NextIndex] >= BestSteps || !IsConnected(Index, NextIndex))
+			{
+				continue;
+			}
+
+			// 斜向移动要求两侧的正交格子都可到达，避免穿过墙角
+			if (Offset.X != 0 && Offset.Y != 0)
+			{
+				const int32 SideX = Local.Y * Size + Next.X;
+				const int32 SideY = Next.Y * Size + Local.X;
+				if (Steps[SideX] == INDEX_NONE || Steps[SideY] == INDEX_NONE)
+				{
+					continue;
+				}
+			}
+
+			BestSteps = Steps[NextIndex];
+			BestDir = static_cast<uint8>(Dir);
+		}
+
+		Directions[Index] = BestDir;
+	}
+
+	return true;
+}
+
+/**
+ * 查询前进方向
+ *
+ * @param NavGrid 构建时使用的导航网格采样缓存
+ * @param Location 查询位置
+ * @param OutDirection 输出：朝下一个格子中心的水平单位向量
+ * @return 位置在流场内且能到达目标时返回true
+ */
+bool FSDTAFlowField::GetDirection(const FSDTANavGrid& NavGrid, const FVector& Location, FVector& OutDirection) const
+{
+	const FIntPoint Cell = NavGrid.WorldToCell(Location);
+	const int32 Index = ToLocalIndex(Cell);
+	if (Index == INDEX_NONE || Directions[Index] == NoDirection)
+	{
+		return false;
+	}
+
+	const FVector NextCenter = NavGrid.CellToWorld(Cell + SDTAFlowField::NeighborOffsets[Directions[Index]]);
+	OutDirection = (NextCenter - Location).GetSafeNormal2D();
+	return !OutDirection.IsNearlyZero();
+}
+
+/**
+ * 清空流场
+ */
+void FSDTAFlowField::Reset()
+{
+	Size = 0;
+	Directions.Reset();
+}
+
+/**
+ * 流场局部下标
+ *
+ * @param Cell 格子坐标
+ * @return 局部下标，不在流场内时返回INDEX_NONE
+ */
+int32 FSDTAFlowField::ToLocalIndex(const FIntPoint& Cell) const
+{
+	const FIntPoint Local = Cell - Origin;
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= Size || Local.Y >= Size)
+	{
+		return INDEX_NONE;
+	}
+
+	return Local.Y * Size + Local.X;
+}
+
+#pragma endregion
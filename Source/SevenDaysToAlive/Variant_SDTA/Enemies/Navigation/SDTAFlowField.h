@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * 导航网格采样缓存
+ *
+ * 核心功能：
+ * 1. 将XY平面划分为世界对齐的格子，每个格子中心投影到导航网格一次，缓存是否可行走及地面高度
+ * 2. 多个流场共享同一份缓存，玩家移动后只需要补采新进入范围的格子
+ *
+ * 设计要点：
+ * - 缓存是二维的，每个格子只记录一个高度，适合开阔的地表场景；多层结构下以参考高度附近的层为准
+ * - 采样次数受每帧预算限制，尚未采样的格子暂时视为不可行走，随后的构建中逐步补全
+ * - 导航网格变化后调用Reset丢弃缓存；格子数量超出上限时由调用方调用EvictFarCells丢弃远离所有玩家的格子
+ */
+class SEVENDAYSTOALIVE_API FSDTANavGrid
+{
+public:
+	/** 格子采样结果 */
+	struct FCell
+	{
+		float Height = 0.0f; // 投影到导航网格后的地面高度
+		bool bWalkable = false; // 是否在导航网格上
+	};
+
+	/**
+	 * 设置格子尺寸（尺寸变化时清空缓存）
+	 *
+	 * @param InCellSize 格子边长（cm）
+	 */
+	void Configure(float InCellSize);
+
+	/**
+	 * 查找格子，尚未采样且预算允许时立即投影采样
+	 *
+	 * @param World 游戏世界
+	 * @param Cell 格子坐标
+	 * @param ReferenceZ 投影的参考高度
+	 * @param InOutProbeBudget 输入输出：本帧剩余的采样次数
+	 * @return 已采样时返回格子，否则返回nullptr
+	 */
+	const FCell* FindOrProbe(UWorld* World, const FIntPoint& Cell, float ReferenceZ, int32& InOutProbeBudget);
+
+	/** 世界坐标所在的格子 */
+	FIntPoint WorldToCell(const FVector& Location) const;
+
+	/** 格子中心的世界坐标（Z为0） */
+	FVector CellToWorld(const FIntPoint& Cell) const;
+
+	/** 格子边长 */
+	float GetCellSize() const { return CellSize; }
+
+	/** 已采样的格子数量 */
+	int32 Num() const { return Cells.Num(); }
+
+	/** 丢弃所有采样结果（导航网格变化后调用） */
+	void Reset() { Cells.Reset(); }
+
+	/**
+	 * 丢弃远离所有保留中心的格子
+	 *
+	 * @param KeepCenters 保留中心的格子坐标（通常为玩家所在格子）
+	 * @param KeepRadiusCells 保留半径（格子数，按切比雪夫距离计算）
+	 * @return 丢弃的格子数量
+	 */
+	int32 EvictFarCells(TConstArrayView<FIntPoint> KeepCenters, int32 KeepRadiusCells);
+
+private:
+	/** 格子边长（cm） */
+	float CellSize = 100.0f;
+
+	/** 投影时的竖直搜索半高（cm） */
+	static constexpr float ProbeHalfHeight = 500.0f;
+
+	/** 已采样的格子 */
+	TMap<FIntPoint, FCell> Cells;
+};
+
+/**
+ * 流场
+ *
+ * 核心功能：
+ * 1. 以目标所在格子为中心、半径RadiusCells的正方形区域内，从目标向外做广度优先搜索，得到每个格子到目标的步数
+ * 2. 每个格子记录指向步数最小的相邻格子的方向，敌人只需按所在格子查表即可获得前进方向
+ *
+ * 设计要点：
+ * - 同一目标的所有敌人共享一个流场，寻路开销与敌人数量无关
+ * - 相邻格子的高度差超过MaxStepHeight时视为不连通；斜向移动要求两侧的正交格子都可行走，避免贴墙穿角
+ * - 方向以一字节编码存储（0~7，无方向为0xFF），查询时再换算为朝相邻格子中心的单位向量
+ */
+class SEVENDAYSTOALIVE_API FSDTAFlowField
+{
+public:
+	/**
+	 * 构建流场
+	 *
+	 * @param World 游戏世界
+	 * @param NavGrid 导航网格采样缓存
+	 * @param GoalLocation 目标位置
+	 * @param RadiusCells 流场半径（格子数）
+	 * @param MaxStepHeight 相邻格子间允许的最大高度差（cm）
+	 * @param InOutProbeBudget 输入输出：本帧剩余的导航网格采样次数
+	 * @param bOutComplete 输出：范围内的格子是否都已采样（采样预算用完时为false，需要之后重建）
+	 * @return 目标所在格子可行走时返回true
+	 */
+	bool Build(UWorld* World, FSDTANavGrid& NavGrid, const FVector& GoalLocation, int32 RadiusCells, float MaxStepHeight, int32& InOutProbeBudget, bool& bOutComplete);
+
+	/**
+	 * 查询前进方向
+	 *
+	 * @param NavGrid 构建时使用的导航网格采样缓存
+	 * @param Location 查询位置
+	 * @param OutDirection 输出：朝下一个格子中心的水平单位向量
+	 * @return 位置在流场内且能到达目标时返回true
+	 */
+	bool GetDirection(const FSDTANavGrid& NavGrid, const FVector& Location, FVector& OutDirection) const;
+
+	/** 流场是否已构建 */
+	bool IsValid() const { return Size > 0; }
+
+	/** 构建时的目标格子 */
+	const FIntPoint& GetGoalCell() const { return GoalCell; }
+
+	/** 清空流场 */
+	void Reset();
+
+private:
+	/** 无方向（不可到达或目标格子） */
+	static constexpr uint8 NoDirection = 0xFF;
+
+	/** 流场局部下标 */
+	int32 ToLocalIndex(const FIntPoint& Cell) const;
+
+	/** 目标格子 */
+	FIntPoint GoalCell = FIntPoint::ZeroValue;
+
+	/** 流场左下角格子 */
+	FIntPoint Origin = FIntPoint::ZeroValue;
+
+	/** 流场边长（格子数），0表示未构建 */
+	int32 Size = 0;
+
+	/** 每个格子的前进方向编码 */
+	TArray<uint8> Directions;
+
+	/** 构建时复用的临时数组：格子高度、到目标的步数、搜索队列 */
+	TArray<float> Heights;
+	TArray<int32> Steps;
+	TArray<int32> Frontier;
+};
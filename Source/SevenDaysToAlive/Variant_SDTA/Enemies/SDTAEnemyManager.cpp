@@ -0,0 +1,715 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAEnemyManager.cpp - 敌人AI更新管理器实现文件
+ *
+ * 实现细节：
+ * - 每帧分三遍处理：读取位置并清理无效敌人 → 批量计算最近玩家距离并按节奏重新选择目标 → 按距离执行攻击或追逐
+ * - 第二遍只访问连续的位置数组和目标选择器，不接触Actor；重新选择目标的时间在敌人之间随机错开
+ * - 追逐时只有目标偏离上次寻路目标超过RepathDistance，或控制器已停止移动时才调用MoveToLocation
+ * - 第二遍同时计算重要性等级；等级变化时才修改骨骼网格和移动组件的Tick设置
+ * - 第三遍跳过尚未到达AI更新时间的敌人，远处敌人的AI决策和寻路频率随等级降低
+ * - 远离玩家的敌人查询玩家的流场，只有靠近玩家或不在流场内的敌人才单独寻路
+ * - 第四遍为所有跟随流场的敌人添加移动输入
+ * - 导航网格采样缓存在导航网格生成完成时清空，超出格子上限时按玩家位置丢弃远处的格子
+ * - 定时器时钟按GameState复制的模拟时间缩放累加，与昼夜和波次使用同一时间缩放
+ */
+
+#include "Variant_SDTA/Enemies/SDTAEnemyManager.h"
+#include "Variant_SDTA/Enemies/AI/CommonEnemy.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyTrace.h"
+#include "Variant_SDTA/Characters/SDTAPlayerBase.h"
+#include "Variant_SDTA/Core/Game/SDTAGameState.h"
+#include "Variant_SDTA/Components/HealthComponent.h"
+#include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NavigationSystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+/** 敌人AI性能统计（stat SDTAEnemy） */
+DECLARE_STATS_GROUP(TEXT("SDTA Enemy"), STATGROUP_SDTAEnemy, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Enemy Manager Tick"), STAT_SDTAEnemy_Tick, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Managed Enemies"), STAT_SDTAEnemy_Managed, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests"), STAT_SDTAEnemy_PathRequests, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Updates"), STAT_SDTAEnemy_AIUpdates, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tier Changes"), STAT_SDTAEnemy_TierChanges, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Retargets"), STAT_SDTAEnemy_Retargets, STATGROUP_SDTAEnemy);
+DECLARE_CYCLE_STAT(TEXT("Enemy Timers"), STAT_SDTAEnemy_Timers, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timers Fired"), STAT_SDTAEnemy_TimersFired, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timers Pending"), STAT_SDTAEnemy_TimersPending, STATGROUP_SDTAEnemy);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Update"), STAT_SDTAEnemy_FlowField, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Builds"), STAT_SDTAEnemy_FlowFieldBuilds, STATGROUP_SDTAEnemy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Followers"), STAT_SDTAEnemy_FlowFollowers, STATGROUP_SDTAEnemy);
+
+USDTAEnemyManager::USDTAEnemyManager()
+	: RepathDistance(150.0f)
+	, VisibilityTolerance(0.5f)
+	, TargetUpdateInterval(0.5f)
+	, TargetCrowdingWeight(0.5f)
+	, TargetSwitchHysteresis(0.2f)
+	, LowHealthThreatBonus(0.5f)
+	, TargetIndexCellSize(2000.0f)
+	, MaxPathRequestsPerFrame(8)
+	, bUseFlowField(true)
+	, FlowFieldCellSize(100.0f)
+	, FlowFieldRadius(2500.0f)
+	, FlowFieldUpdateInterval(0.5f)
+	, FlowFieldDirectDistance(400.0f)
+	, FlowFieldMaxStepHeight(60.0f)
+	, MaxNavProbesPerFrame(256)
+	, MaxNavGridCells(32768)
+	, PathRequestCursor(0)
+	, FlowFollowerCount(0)
+{
+	// 默认重要性等级：近处全精度，中距离降频，远处大幅降频且只在渲染时更新动画
+	FSDTAEnemySignificanceTier& Near = SignificanceTiers.AddDefaulted_GetRef();
+	Near.MaxDistance = 1500.0f;
+	Near.AIUpdateInterval = 0.0f;
+	Near.RepathInterval = 0.25f;
+
+	FSDTAEnemySignificanceTier& Mid = SignificanceTiers.AddDefaulted_GetRef();
+	Mid.MaxDistance = 4000.0f;
+	Mid.AIUpdateInterval = 0.1f;
+	Mid.RepathInterval = 0.75f;
+	Mid.AnimTickInterval = 1.0f / 30.0f;
+	Mid.MaxSimulationIterations = 4;
+
+	FSDTAEnemySignificanceTier& Far = SignificanceTiers.AddDefaulted_GetRef();
+	Far.MaxDistance = 8000.0f;
+	Far.AIUpdateInterval = 0.25f;
+	Far.RepathInterval = 1.5f;
+	Far.AnimTickInterval = 0.1f;
+	Far.bOnlyTickPoseWhenRendered = true;
+	Far.MovementTickInterval = 1.0f / 30.0f;
+	Far.MaxSimulationIterations = 2;
+
+	FSDTAEnemySignificanceTier& Dormant = SignificanceTiers.AddDefaulted_GetRef();
+	Dormant.MaxDistance = 0.0f;
+	Dormant.AIUpdateInterval = 0.5f;
+	Dormant.RepathInterval = 3.0f;
+	Dormant.AnimTickInterval = 0.25f;
+	Dormant.bOnlyTickPoseWhenRendered = true;
+	Dormant.MovementTickInterval = 0.1f;
+	Dormant.MaxSimulationIterations = 1;
+}
+
+/**
+ * 获取世界中的敌人AI更新管理器
+ *
+ * @param WorldContextObject 世界上下文对象
+ * @return 敌人AI更新管理器，不支持的世界返回nullptr
+ */
+USDTAEnemyManager* USDTAEnemyManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USDTAEnemyManager>() : nullptr;
+}
+
+void USDTAEnemyManager::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &USDTAEnemyManager::HandleNavigationGenerationFinished);
+	}
+
+	Enemies.Empty();
+	Controllers.Empty();
+	Locations.Empty();
+	LastMoveTargets.Empty();
+	NextRepathTimes.Empty();
+	NextAIUpdateTimes.Empty();
+	TierIndices.Empty();
+	TierCounts.Empty();
+	AssignedTargets.Empty();
+	NextRetargetTimes.Empty();
+	NearestDistSq.Empty();
+	TargetSlots.Empty();
+	TargetDistSq.Empty();
+	TargetPawns.Empty();
+	TargetLocations.Empty();
+	FlowDirections.Empty();
+	InvalidateFlowFields();
+	TimerWheel.Reset();
+	TimerClock = 0.0;
+
+	Super::Deinitialize();
+}
+
+void USDTAEnemyManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 导航系统在世界初始化时创建，开始游戏时一定已经存在
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &USDTAEnemyManager::HandleNavigationGenerationFinished);
+	}
+}
+
+bool USDTAEnemyManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTAEnemyManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTAEnemyManager, STATGROUP_Tickables);
+}
+
+/**
+ * 注册敌人
+ *
+ * 功能：将敌人追加到结构数组末尾，并在敌人上记录下标
+ *
+ * @param Enemy 敌人实例
+ */
+void USDTAEnemyManager::RegisterEnemy(ACommonEnemy* Enemy)
+{
+	if (!Enemy || Enemy->AIManagerIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Enemy->AIManagerIndex = Enemies.Add(Enemy);
+	Controllers.Add(Cast<AAIController>(Enemy->GetController()));
+	Locations.Add(Enemy->GetActorLocation());
+	LastMoveTargets.Add(FVector(TNumericLimits<float>::Max()));
+	NextRepathTimes.Add(0.0);
+	NextAIUpdateTimes.Add(0.0);
+	TierIndices.Add(INDEX_NONE);
+	FlowDirections.Add(FVector::ZeroVector);
+	AssignedTargets.Add(nullptr);
+	NextRetargetTimes.Add(0.0);
+}
+
+/**
+ * 注销敌人
+ *
+ * @param Enemy 敌人实例
+ */
+void USDTAEnemyManager::UnregisterEnemy(ACommonEnemy* Enemy)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->AIManagerIndex) || Enemies[Enemy->AIManagerIndex] != Enemy)
+	{
+		return;
+	}
+
+	RemoveAt(Enemy->AIManagerIndex);
+}
+
+/**
+ * 设置敌人定时器
+ *
+ * @param Enemy 敌人
+ * @param Timer 定时器类型
+ * @param Delay 延迟（秒）
+ */
+void USDTAEnemyManager::ScheduleEnemyTimer(AEnemyBase* Enemy, ESDTAEnemyTimer Timer, float Delay)
+{
+	// 与Tick中推进时间轮使用同一时钟
+	TimerWheel.Schedule(Enemy, Timer, TimerClock, Delay);
+}
+
+/**
+ * 注销指定下标处的敌人
+ *
+ * 功能：将末尾敌人交换到被删除的位置，并更新其记录的下标
+ *
+ * @param Index 结构数组下标
+ */
+void USDTAEnemyManager::RemoveAt(int32 Index)
+{
+	if (ACommonEnemy* Removed = Enemies[Index])
+	{
+		Removed->AIManagerIndex = INDEX_NONE;
+	}
+
+	if (TierCounts.IsValidIndex(TierIndices[Index]))
+	{
+		TierCounts[TierIndices[Index]]--;
+	}
+
+	Enemies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Controllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LastMoveTargets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	NextRepathTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	NextAIUpdateTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TierIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	FlowDirections.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	AssignedTargets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	NextRetargetTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (Enemies.IsValidIndex(Index) && Enemies[Index])
+	{
+		Enemies[Index]->AIManagerIndex = Index;
+	}
+}
+
+/**
+ * 收集所有存活玩家的位置和威胁系数，重建目标选择器
+ *
+ * 功能：跳过已死亡的玩家；生命值越低的玩家威胁系数越高，越容易被敌人选为目标
+ */
+void USDTAEnemyManager::GatherTargets()
+{
+	TargetPawns.Reset();
+	TargetLocations.Reset();
+	TargetSelector.Reset(TargetIndexCellSize);
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		ASDTAPlayerBase* PlayerPawn = PlayerController ? Cast<ASDTAPlayerBase>(PlayerController->GetPawn()) : nullptr;
+		if (!PlayerPawn)
+		{
+			continue;
+		}
+
+		float ThreatMultiplier = 1.0f;
+		if (const UHealthComponent* Health = PlayerPawn->HealthComponent)
+		{
+			if (Health->IsDead())
+			{
+				continue;
+			}
+
+			if (Health->MaxHealth > 0.0f)
+			{
+				ThreatMultiplier += LowHealthThreatBonus * (1.0f - FMath::Clamp(Health->Health / Health->MaxHealth, 0.0f, 1.0f));
+			}
+		}
+
+		TargetPawns.Add(PlayerPawn);
+		TargetLocations.Add(PlayerPawn->GetActorLocation());
+		TargetSelector.AddTarget(PlayerPawn->GetActorLocation(), ThreatMultiplier);
+	}
+
+	TargetSelector.BuildIndex();
+}
+
+/**
+ * 分配给指定玩家的敌人数量
+ *
+ * @param Player 玩家
+ * @return 本帧以该玩家为目标的敌人数量
+ */
+int32 USDTAEnemyManager::GetEnemyCountTargeting(const ASDTAPlayerBase* Player) const
+{
+	const int32 TargetIndex = TargetPawns.IndexOfByKey(Player);
+	return (TargetIndex != INDEX_NONE && TargetIndex < TargetSelector.Num()) ? TargetSelector.GetAssignedCount(TargetIndex) : 0;
+}
+
+/**
+ * 按距离和可见性计算敌人的重要性等级
+ *
+ * 功能：取第一个MaxDistance不小于当前距离的等级，都不满足时取最后一级；
+ *       近处等级以外的敌人若最近未被渲染，再降低一级
+ *
+ * @param Enemy 敌人实例
+ * @param DistSq 到最近玩家的距离平方
+ * @param bCheckVisibility 是否考虑可见性（专用服务器不渲染，不考虑）
+ * @return 等级下标
+ */
+int32 USDTAEnemyManager::ComputeTier(const ACommonEnemy* Enemy, float DistSq, bool bCheckVisibility) const
+{
+	const int32 LastTier = SignificanceTiers.Num() - 1;
+
+	int32 TierIndex = LastTier;
+	for (int32 Index = 0; Index < LastTier; ++Index)
+	{
+		if (DistSq <= FMath::Square(SignificanceTiers[Index].MaxDistance))
+		{
+			TierIndex = Index;
+			break;
+		}
+	}
+
+	if (bCheckVisibility && TierIndex > 0 && TierIndex < LastTier && !Enemy->WasRecentlyRendered(VisibilityTolerance))
+	{
+		TierIndex++;
+	}
+
+	return TierIndex;
+}
+
+/**
+ * 将重要性等级的设置应用到敌人的组件
+ *
+ * @param Enemy 敌人实例
+ * @param TierIndex 等级下标
+ */
+void USDTAEnemyManager::ApplyTier(ACommonEnemy* Enemy, int32 TierIndex) const
+{
+	const FSDTAEnemySignificanceTier& Tier = SignificanceTiers[TierIndex];
+
+	if (USkeletalMeshComponent* Mesh = Enemy->GetMesh())
+	{
+		Mesh->SetComponentTickInterval(Tier.AnimTickInterval);
+		Mesh->VisibilityBasedAnimTickOption = Tier.bOnlyTickPoseWhenRendered ?
+			EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	}
+
+	if (UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+	{
+		Movement->SetComponentTickInterval(Tier.MovementTickInterval);
+		Movement->MaxSimulationIterations = Tier.MaxSimulationIterations;
+	}
+}
+
+/**
+ * 每帧更新所有敌人的AI
+ *
+ * 功能：批量计算整群敌人到最近玩家的距离并更新重要性等级，
+ *       到达AI更新时间的敌人进入攻击范围则攻击，进入追逐范围则跟随流场或按需重新寻路
+ *
+ * @param DeltaTime 帧间隔
+ */
+void USDTAEnemyManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTAEnemy_Tick);
+	SET_DWORD_STAT(STAT_SDTAEnemy_Managed, Enemies.Num());
+	SET_DWORD_STAT(STAT_SDTAEnemy_PathRequests, 0);
+	SET_DWORD_STAT(STAT_SDTAEnemy_AIUpdates, 0);
+	SET_DWORD_STAT(STAT_SDTAEnemy_TierChanges, 0);
+	SET_DWORD_STAT(STAT_SDTAEnemy_FlowFieldBuilds, 0);
+	SET_DWORD_STAT(STAT_SDTAEnemy_Retargets, 0);
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// 敌人定时器在所有端推进（受击/死亡动画完成也可能由客户端设置）
+	// 按游戏规则层的模拟时间缩放推进，sdta.Sim.TimeScale为0时定时器与昼夜和波次一起暂停
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SDTAEnemy_Timers);
+		const ASDTAGameState* SDTAGameState = World->GetGameState<ASDTAGameState>();
+		const float TimeScale = SDTAGameState ? SDTAGameState->SimulationTimeScale : 1.0f;
+		TimerClock += static_cast<double>(DeltaTime) * TimeScale;
+
+		const int32 TimersFired = TimerWheel.Advance(TimerClock);
+		SET_DWORD_STAT(STAT_SDTAEnemy_TimersFired, TimersFired);
+		SET_DWORD_STAT(STAT_SDTAEnemy_TimersPending, TimerWheel.GetPendingCount());
+	}
+
+	if (Enemies.Num() == 0 || World->GetNetMode() == NM_Client || SignificanceTiers.Num() == 0)
+	{
+		return;
+	}
+
+	GatherTargets();
+
+	// 第一遍：清理无效或已停放的敌人，读取位置
+	for (int32 Index = Enemies.Num() - 1; Index >= 0; --Index)
+	{
+		ACommonEnemy* Enemy = Enemies[Index];
+		if (!IsValid(Enemy) || Enemy->IsActorBeingDestroyed() || Enemy->IsHidden())
+		{
+			RemoveAt(Index);
+			continue;
+		}
+
+		Locations[Index] = Enemy->GetActorLocation();
+	}
+
+	const int32 NumEnemies = Enemies.Num();
+	SET_DWORD_STAT(STAT_SDTAEnemy_Managed, NumEnemies);
+	if (NumEnemies == 0 || TargetLocations.Num() == 0)
+	{
+		return;
+	}
+
+	// 当前目标换算为本帧的玩家下标，并统计每个玩家的已分配数量
+	TargetSlots.SetNumUninitialized(NumEnemies, EAllowShrinking::No);
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		TargetSlots[Index] = AssignedTargets[Index] ? TargetPawns.IndexOfByKey(AssignedTargets[Index]) : INDEX_NONE;
+		TargetSelector.Reassign(INDEX_NONE, TargetSlots[Index]);
+	}
+
+	// 第二遍：只访问连续的位置数组和目标选择器，批量计算最近玩家并按节奏重新选择目标
+	const double Now = World->GetTimeSeconds();
+	NearestDistSq.SetNumUninitialized(NumEnemies, EAllowShrinking::No);
+	TargetDistSq.SetNumUninitialized(NumEnemies, EAllowShrinking::No);
+	int32 Retargets = 0;
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		const FVector& Location = Locations[Index];
+		TargetSelector.FindNearest(Location, NearestDistSq[Index]);
+
+		int32& TargetSlot = TargetSlots[Index];
+		if (TargetSlot == INDEX_NONE || Now >= NextRetargetTimes[Index])
+		{
+			const int32 NewSlot = TargetSelector.SelectTarget(Location, TargetSlot, TargetCrowdingWeight, TargetSwitchHysteresis);
+			TargetSelector.Reassign(TargetSlot, NewSlot);
+			TargetSlot = NewSlot;
+
+			// 首次选择目标时随机错开，之后按固定间隔
+			NextRetargetTimes[Index] = Now + TargetUpdateInterval * (NextRetargetTimes[Index] > 0.0 ? 1.0f : FMath::FRand());
+			Retargets++;
+		}
+
+		TargetDistSq[Index] = FVector::DistSquared(Location, TargetSelector.GetLocation(TargetSlot));
+		AssignedTargets[Index] = TargetPawns[TargetSlot];
+	}
+
+	SET_DWORD_STAT(STAT_SDTAEnemy_Retargets, Retargets);
+
+	// 更新重要性等级，只在等级变化时修改组件设置
+	const bool bCheckVisibility = World->GetNetMode() != NM_DedicatedServer;
+	if (TierCounts.Num() != SignificanceTiers.Num())
+	{
+		// 等级配置在运行时被修改，全部重新分级
+		TierCounts.Init(0, SignificanceTiers.Num());
+		for (int32& TierIndex : TierIndices)
+		{
+			TierIndex = INDEX_NONE;
+		}
+	}
+	int32 TierChanges = 0;
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		ACommonEnemy* Enemy = Enemies[Index];
+		const int32 NewTier = ComputeTier(Enemy, NearestDistSq[Index], bCheckVisibility);
+		int32& CurrentTier = TierIndices[Index];
+		if (NewTier == CurrentTier)
+		{
+			continue;
+		}
+
+		if (TierCounts.IsValidIndex(CurrentTier))
+		{
+			TierCounts[CurrentTier]--;
+		}
+		TierCounts[NewTier]++;
+		CurrentTier = NewTier;
+
+		ApplyTier(Enemy, NewTier);
+		SDTA_ENEMY_TRACE(Enemy, TierChanged, NewTier);
+
+		// 在新等级的更新间隔内随机错开，避免同时换级的敌人在同一帧集中更新
+		NextAIUpdateTimes[Index] = FMath::Min(NextAIUpdateTimes[Index], Now + FMath::FRand() * SignificanceTiers[NewTier].AIUpdateInterval);
+		TierChanges++;
+	}
+
+	// 第三遍：到达AI更新时间的敌人按距离执行攻击或追逐
+	if (bUseFlowField)
+	{
+		UpdateFlowFields(Now);
+	}
+
+	const float RepathDistanceSq = FMath::Square(RepathDistance);
+	const float DirectDistanceSq = FMath::Square(FlowFieldDirectDistance);
+	const int32 StartIndex = (PathRequestCursor > 0 && PathRequestCursor < NumEnemies) ? PathRequestCursor : 0;
+	PathRequestCursor = INDEX_NONE;
+	int32 PathRequests = 0;
+	int32 AIUpdates = 0;
+
+	// 从上一帧寻路预算用尽处开始遍历，使预算在敌人之间轮转
+	for (int32 Step = 0; Step < NumEnemies; ++Step)
+	{
+		const int32 Index = (StartIndex + Step) % NumEnemies;
+		if (Now < NextAIUpdateTimes[Index])
+		{
+			continue;
+		}
+
+		const FSDTAEnemySignificanceTier& Tier = SignificanceTiers[TierIndices[Index]];
+		NextAIUpdateTimes[Index] = Now + Tier.AIUpdateInterval;
+		AIUpdates++;
+
+		ACommonEnemy* Enemy = Enemies[Index];
+		if (const UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+		{
+			Enemy->IsMoving = Movement->Velocity.SizeSquared2D() > 1.0f;
+		}
+
+		FVector& FlowDirection = FlowDirections[Index];
+		const bool bWasFollowingFlow = !FlowDirection.IsZero();
+		FlowDirection = FVector::ZeroVector;
+
+		if (Enemy->IsDead())
+		{
+			continue;
+		}
+
+		ASDTAPlayerBase* Target = TargetPawns[TargetSlots[Index]];
+		const FVector& TargetLocation = TargetLocations[TargetSlots[Index]];
+		Enemy->SetTargetPlayer(Target);
+
+		if (TargetDistSq[Index] <= FMath::Square(Enemy->AttackRange))
+		{
+			Enemy->AttackPlayer();
+			continue;
+		}
+
+		if (TargetDistSq[Index] > FMath::Square(Enemy->ChaseRange))
+		{
+			continue;
+		}
+
+		// 控制器在注册后才完成控制时补取
+		AAIController*& Controller = Controllers[Index];
+		if (!Controller)
+		{
+			Controller = Cast<AAIController>(Enemy->GetController());
+		}
+
+		// 远离玩家时跟随该玩家的流场，只做一次查表
+		if (bUseFlowField && TargetDistSq[Index] > DirectDistanceSq && TargetFlowFields.IsValidIndex(TargetSlots[Index]))
+		{
+			const FTargetFlowField& Flow = FlowFields[TargetFlowFields[TargetSlots[Index]]];
+			if (Flow.bValid && Flow.Field.GetDirection(NavGrid, Locations[Index], FlowDirection))
+			{
+				// 从单独寻路切换到流场时停止路径跟随，避免与移动输入冲突
+				if (!bWasFollowingFlow)
+				{
+					if (Controller)
+					{
+						Controller->StopMovement();
+					}
+					SDTA_ENEMY_TRACE(Enemy, FlowFollow, FMath::Sqrt(TargetDistSq[Index]));
+				}
+
+				// 回到单独寻路时立即重新请求路径
+				LastMoveTargets[Index] = FVector(TNumericLimits<float>::Max());
+				continue;
+			}
+		}
+
+		// 没有AI控制器时直接添加移动输入，每帧都需要调用
+		if (!Controller)
+		{
+			Enemy->ChasePlayer();
+			continue;
+		}
+
+		const bool bTargetMoved = FVector::DistSquared(TargetLocation, LastMoveTargets[Index]) > RepathDistanceSq;
+		const bool bMoveStopped = bWasFollowingFlow || Controller->GetMoveStatus() == EPathFollowingStatus::Idle;
+		if ((bTargetMoved || bMoveStopped) && Now >= NextRepathTimes[Index])
+		{
+			// 寻路预算用尽时不再推迟更新时间，下一帧从这里继续
+			if (PathRequests >= MaxPathRequestsPerFrame)
+			{
+				NextAIUpdateTimes[Index] = Now;
+				if (PathRequestCursor == INDEX_NONE)
+				{
+					PathRequestCursor = Index;
+				}
+				continue;
+			}
+
+			Enemy->ChasePlayer();
+			SDTA_ENEMY_TRACE(Enemy, PathRequest, FMath::Sqrt(TargetDistSq[Index]));
+			LastMoveTargets[Index] = TargetLocation;
+			NextRepathTimes[Index] = Now + Tier.RepathInterval;
+			PathRequests++;
+		}
+	}
+
+	// 第四遍：跟随流场的敌人每帧沿缓存的方向移动
+	FlowFollowerCount = 0;
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		if (!FlowDirections[Index].IsZero())
+		{
+			Enemies[Index]->AddMovementInput(FlowDirections[Index]);
+			FlowFollowerCount++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SDTAEnemy_PathRequests, PathRequests);
+	SET_DWORD_STAT(STAT_SDTAEnemy_AIUpdates, AIUpdates);
+	SET_DWORD_STAT(STAT_SDTAEnemy_TierChanges, TierChanges);
+	SET_DWORD_STAT(STAT_SDTAEnemy_FlowFollowers, FlowFollowerCount);
+}
+
+/**
+ * 为本帧的每个玩家匹配流场，到期的流场重新构建
+ *
+ * 功能：丢弃已离开的玩家的流场，为新玩家创建流场；
+ *       到达构建时间且玩家离开了原来的格子或上次构建时有格子尚未采样，才重新构建；
+ *       最后在采样缓存超出上限时丢弃远离所有玩家的格子
+ *
+ * @param Now 当前时间
+ */
+void USDTAEnemyManager::UpdateFlowFields(double Now)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTAEnemy_FlowField);
+
+	NavGrid.Configure(FlowFieldCellSize);
+
+	FlowFields.RemoveAllSwap([](const FTargetFlowField& Flow) { return !Flow.Target.IsValid(); }, EAllowShrinking::No);
+
+	const int32 RadiusCells = FMath::CeilToInt(FlowFieldRadius / NavGrid.GetCellSize());
+	int32 ProbeBudget = MaxNavProbesPerFrame;
+	int32 Builds = 0;
+
+	TargetFlowFields.SetNumUninitialized(TargetPawns.Num(), EAllowShrinking::No);
+	for (int32 TargetIndex = 0; TargetIndex < TargetPawns.Num(); ++TargetIndex)
+	{
+		const AActor* Target = TargetPawns[TargetIndex];
+		int32 FlowIndex = FlowFields.IndexOfByPredicate([Target](const FTargetFlowField& Flow) { return Flow.Target.Get() == Target; });
+		if (FlowIndex == INDEX_NONE)
+		{
+			FlowIndex = FlowFields.AddDefaulted();
+			FlowFields[FlowIndex].Target = Target;
+		}
+		TargetFlowFields[TargetIndex] = FlowIndex;
+
+		FTargetFlowField& Flow = FlowFields[FlowIndex];
+		if (Now < Flow.NextBuildTime)
+		{
+			continue;
+		}
+
+		const FVector& GoalLocation = TargetLocations[TargetIndex];
+		if (Flow.bComplete && Flow.Field.IsValid() && NavGrid.WorldToCell(GoalLocation) == Flow.Field.GetGoalCell())
+		{
+			continue;
+		}
+
+		Flow.bValid = Flow.Field.Build(GetWorld(), NavGrid, GoalLocation, RadiusCells, FlowFieldMaxStepHeight, ProbeBudget, Flow.bComplete);
+		Flow.NextBuildTime = Now + FlowFieldUpdateInterval;
+		Builds++;
+	}
+
+	SET_DWORD_STAT(STAT_SDTAEnemy_FlowFieldBuilds, Builds);
+
+	// 采样缓存超出上限时只保留玩家附近的格子（保留两倍流场半径，玩家小范围往返时不必重新采样）
+	const int32 KeepRadiusCells = RadiusCells * 2;
+	const int32 CellsPerTarget = FMath::Square(KeepRadiusCells * 2 + 1);
+	const int32 CellLimit = FMath::Max(MaxNavGridCells, CellsPerTarget * TargetLocations.Num());
+	if (NavGrid.Num() > CellLimit)
+	{
+		TArray<FIntPoint, TInlineAllocator<8>> KeepCenters;
+		for (const FVector& TargetLocation : TargetLocations)
+		{
+			KeepCenters.Add(NavGrid.WorldToCell(TargetLocation));
+		}
+
+		NavGrid.EvictFarCells(KeepCenters, KeepRadiusCells);
+	}
+}
+
+void USDTAEnemyManager::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	InvalidateFlowFields();
+}
+
+/**
+ * 丢弃导航网格采样缓存和所有流场
+ */
+void USDTAEnemyManager::InvalidateFlowFields()
+{
+	NavGrid.Reset();
+	FlowFields.Reset();
+	TargetFlowFields.Reset();
+}
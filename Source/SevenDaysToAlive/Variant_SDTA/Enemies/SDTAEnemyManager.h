@@ -0,0 +1,327 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Variant_SDTA/Enemies/Navigation/SDTAFlowField.h"
+#include "Variant_SDTA/Enemies/SDTATargetSelector.h"
+#include "Variant_SDTA/Enemies/SDTAEnemyTimerWheel.h"
+#include "SDTAEnemyManager.generated.h"
+
+class AActor;
+class ACommonEnemy;
+class AAIController;
+
+/**
+ * 敌人重要性等级配置
+ *
+ * 按到最近玩家的距离（以及是否可见）为敌人分级，每一级控制AI更新频率、寻路刷新间隔、动画和移动组件的精度
+ */
+USTRUCT(BlueprintType)
+struct SEVENDAYSTOALIVE_API FSDTAEnemySignificanceTier
+{
+	GENERATED_BODY()
+
+	/** 该等级覆盖的最大距离（最后一级覆盖所有更远的敌人） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 0, Units = "cm"))
+	float MaxDistance = 1500.0f;
+
+	/** AI决策（攻击/追逐判断）的更新间隔，0表示每帧 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 0, Units = "s"))
+	float AIUpdateInterval = 0.0f;
+
+	/** 两次寻路请求之间的最小间隔 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 0, Units = "s"))
+	float RepathInterval = 0.25f;
+
+	/** 骨骼网格（动画）的Tick间隔，0表示每帧 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 0, Units = "s"))
+	float AnimTickInterval = 0.0f;
+
+	/** 是否只在被渲染时更新动画姿势 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance")
+	bool bOnlyTickPoseWhenRendered = false;
+
+	/** 角色移动组件的Tick间隔，0表示每帧 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 0, Units = "s"))
+	float MovementTickInterval = 0.0f;
+
+	/** 角色移动组件每次Tick的最大模拟迭代次数 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 1))
+	int32 MaxSimulationIterations = 8;
+};
+
+/**
+ * 敌人AI更新管理器
+ *
+ * 核心功能：
+ * 1. 集中更新所有ACommonEnemy的AI，替代每个敌人各自的Tick
+ * 2. 每帧先把敌人位置读入连续数组，再通过玩家空间索引一次性计算整群敌人到最近玩家的距离
+ * 3. 只有目标移动超过RepathDistance或寻路已停止时才重新发起寻路请求
+ * 4. 按距离和可见性为敌人分配重要性等级，远处和不可见的敌人降低AI、寻路、动画和移动的更新频率
+ * 5. 多人目标选择：每个敌人每隔TargetUpdateInterval按距离、玩家威胁和已分配敌人数量选择目标，
+ *    敌人分散追逐多个玩家，不再全部追逐0号玩家
+ * 6. 尸潮导航：每个玩家每隔FlowFieldUpdateInterval构建一次流场，追逐该玩家的敌人按所在格子查表移动，
+ *    只有靠近玩家或不在流场内的敌人才单独寻路，单独寻路请求数受每帧预算限制；
+ *    导航网格生成完成后丢弃采样缓存和流场，采样缓存超出上限时丢弃远离所有玩家的格子
+ * 7. 敌人定时器时间轮：所有敌人的受击/死亡动画完成和攻击冷却在每帧一次遍历中处理
+ *
+ * 设计要点：
+ * - 结构数组（SoA）存储：敌人、控制器、位置、上次寻路目标等分别连续存放，注册/注销为O(1)交换删除
+ * - 敌人在BeginPlay和借出时注册，回收和EndPlay时注销；被隐藏（停放在对象池中）的敌人在更新时顺带注销
+ * - 等级只在变化时才修改组件设置；切换等级时随机错开下次AI更新，避免同一级的敌人在同一帧集中更新
+ * - 跟随流场的敌人每帧都沿缓存的方向添加移动输入，方向只在AI更新时刷新
+ * - 超出寻路预算的敌人保持待寻路状态，下一帧从上次中断处继续分配预算，避免固定的敌人一直得不到寻路
+ * - AI只在服务器（含单机）上更新，AI控制器只存在于服务器；定时器时间轮在所有端推进
+ * - 作为世界子系统随世界创建和销毁，通过USDTAEnemyManager::Get直接获取
+ */
+UCLASS()
+class SEVENDAYSTOALIVE_API USDTAEnemyManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	USDTAEnemyManager();
+
+	/**
+	 * 获取世界中的敌人AI更新管理器
+	 * @param WorldContextObject 世界上下文对象
+	 * @return 敌人AI更新管理器，不支持的世界返回nullptr
+	 */
+	static USDTAEnemyManager* Get(const UObject* WorldContextObject);
+
+	// USubsystem接口
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem接口
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject接口
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** 注册敌人（已注册时忽略） */
+	void RegisterEnemy(ACommonEnemy* Enemy);
+
+	/** 注销敌人（未注册时忽略） */
+	void UnregisterEnemy(ACommonEnemy* Enemy);
+
+	/**
+	 * 设置敌人定时器（由AEnemyBase::StartEnemyTimer调用）
+	 *
+	 * @param Enemy 敌人
+	 * @param Timer 定时器类型
+	 * @param Delay 延迟（秒）
+	 */
+	void ScheduleEnemyTimer(class AEnemyBase* Enemy, ESDTAEnemyTimer Timer, float Delay);
+
+	/** 当前管理的敌人数量 */
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	int32 GetManagedEnemyCount() const { return Enemies.Num(); }
+
+	/**
+	 * 分配给指定玩家的敌人数量
+	 * @param Player 玩家
+	 * @return 本帧以该玩家为目标的敌人数量
+	 */
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	int32 GetEnemyCountTargeting(const class ASDTAPlayerBase* Player) const;
+
+	/** 当前跟随流场移动的敌人数量 */
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	int32 GetFlowFollowerCount() const { return FlowFollowerCount; }
+
+	/** 丢弃导航网格采样缓存和所有流场（导航网格变化后调用） */
+	UFUNCTION(BlueprintCallable, Category = "Enemy AI|Flow Field")
+	void InvalidateFlowFields();
+
+	/** 导航网格生成完成（包括运行时动态重建）时丢弃采样缓存和流场 */
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(class ANavigationData* NavData);
+
+	/** 指定重要性等级中的敌人数量 */
+	UFUNCTION(BlueprintPure, Category = "Enemy AI")
+	int32 GetEnemyCountInTier(int32 TierIndex) const { return TierCounts.IsValidIndex(TierIndex) ? TierCounts[TierIndex] : 0; }
+
+protected:
+	// 只在游戏世界（含PIE）中创建
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** 注销指定下标处的敌人（交换删除） */
+	void RemoveAt(int32 Index);
+
+	/** 收集所有存活玩家的位置和威胁系数，重建目标选择器 */
+	void GatherTargets();
+
+	/** 按距离和可见性计算敌人的重要性等级 */
+	int32 ComputeTier(const ACommonEnemy* Enemy, float DistSq, bool bCheckVisibility) const;
+
+	/** 将重要性等级的设置应用到敌人的组件 */
+	void ApplyTier(ACommonEnemy* Enemy, int32 TierIndex) const;
+
+	/** 为本帧的每个玩家匹配流场，到期的流场重新构建 */
+	void UpdateFlowFields(double Now);
+
+public:
+	/** 追逐时目标移动超过该距离才重新寻路 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = 0, Units = "cm"))
+	float RepathDistance;
+
+	/** 重要性等级，按MaxDistance升序排列（第0级最重要） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance")
+	TArray<FSDTAEnemySignificanceTier> SignificanceTiers;
+
+	/** 超过该时间未被渲染的敌人视为不可见，降低一级（第0级以内的敌人不降级） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Significance", meta = (ClampMin = 0, Units = "s"))
+	float VisibilityTolerance;
+
+	/** 重新选择目标的间隔 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Targeting", meta = (ClampMin = 0, Units = "s"))
+	float TargetUpdateInterval;
+
+	/** 拥挤权重：已分配敌人越多的玩家评分越差，0表示只按距离和威胁选择 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Targeting", meta = (ClampMin = 0))
+	float TargetCrowdingWeight;
+
+	/** 切换目标所需的最小评分优势（0~1），避免在两个玩家间来回切换 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Targeting", meta = (ClampMin = 0, ClampMax = 1))
+	float TargetSwitchHysteresis;
+
+	/** 低生命值玩家的额外威胁系数（生命值为0时威胁系数为1 + 该值） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Targeting", meta = (ClampMin = 0))
+	float LowHealthThreatBonus;
+
+	/** 玩家空间索引的格子边长 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Targeting", meta = (ClampMin = 100, Units = "cm"))
+	float TargetIndexCellSize;
+
+	/** 每帧最多发起的单独寻路请求数量 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = 1))
+	int32 MaxPathRequestsPerFrame;
+
+	/** 是否启用尸潮流场导航 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field")
+	bool bUseFlowField;
+
+	/** 流场格子边长 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 10, Units = "cm"))
+	float FlowFieldCellSize;
+
+	/** 流场半径（应不小于敌人的追逐范围） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 0, Units = "cm"))
+	float FlowFieldRadius;
+
+	/** 流场重新构建的间隔 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 0, Units = "s"))
+	float FlowFieldUpdateInterval;
+
+	/** 与玩家距离小于该值的敌人不再跟随流场，改为单独寻路精确接近 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 0, Units = "cm"))
+	float FlowFieldDirectDistance;
+
+	/** 相邻格子间允许的最大高度差 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 0, Units = "cm"))
+	float FlowFieldMaxStepHeight;
+
+	/** 每帧最多的导航网格采样次数（补全流场格子） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 1))
+	int32 MaxNavProbesPerFrame;
+
+	/**
+	 * 导航网格采样缓存的格子数量上限
+	 *
+	 * 超出时丢弃距离所有玩家超过两倍流场半径的格子；实际上限不低于所有玩家保留范围的格子总数，避免每帧反复丢弃
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI|Flow Field", meta = (ClampMin = 1))
+	int32 MaxNavGridCells;
+
+protected:
+	/** 管理的敌人 */
+	UPROPERTY()
+	TArray<ACommonEnemy*> Enemies;
+
+	/** 敌人的AI控制器（与Enemies一一对应，尚未被控制时为空） */
+	UPROPERTY()
+	TArray<AAIController*> Controllers;
+
+	/** 本帧敌人位置 */
+	TArray<FVector> Locations;
+
+	/** 上次寻路请求的目标位置 */
+	TArray<FVector> LastMoveTargets;
+
+	/** 允许再次发起寻路请求的时间 */
+	TArray<double> NextRepathTimes;
+
+	/** 下次AI决策的时间 */
+	TArray<double> NextAIUpdateTimes;
+
+	/** 当前重要性等级（INDEX_NONE表示尚未分配） */
+	TArray<int32> TierIndices;
+
+	/** 每个重要性等级中的敌人数量 */
+	TArray<int32> TierCounts;
+
+	/** 当前目标玩家（与Enemies一一对应） */
+	UPROPERTY()
+	TArray<class ASDTAPlayerBase*> AssignedTargets;
+
+	/** 下次重新选择目标的时间 */
+	TArray<double> NextRetargetTimes;
+
+	/** 本帧到最近玩家的距离平方（用于重要性等级） */
+	TArray<float> NearestDistSq;
+
+	/** 本帧目标玩家的下标（对应TargetPawns） */
+	TArray<int32> TargetSlots;
+
+	/** 本帧到目标玩家的距离平方（用于攻击和追逐） */
+	TArray<float> TargetDistSq;
+
+	/** 本帧的玩家 */
+	UPROPERTY()
+	TArray<class ASDTAPlayerBase*> TargetPawns;
+
+	/** 本帧的玩家位置 */
+	TArray<FVector> TargetLocations;
+
+	/** 玩家空间索引和目标选择 */
+	FSDTATargetSelector TargetSelector;
+
+	/** 敌人定时器时间轮 */
+	FSDTAEnemyTimerWheel TimerWheel;
+
+	/** 敌人定时器时钟（秒，按游戏规则层的模拟时间缩放累加，缩放为0时定时器暂停） */
+	double TimerClock = 0.0;
+
+	/** 跟随流场时的移动方向（与Enemies一一对应，零向量表示未跟随流场） */
+	TArray<FVector> FlowDirections;
+
+	/**
+	 * 玩家流场
+	 */
+	struct FTargetFlowField
+	{
+		TWeakObjectPtr<const AActor> Target; // 流场目标
+		FSDTAFlowField Field; // 流场
+		double NextBuildTime = 0.0; // 下次构建时间
+		bool bValid = false; // 最近一次构建是否成功
+		bool bComplete = false; // 最近一次构建时范围内的格子是否都已采样
+	};
+
+	/** 所有玩家的流场 */
+	TArray<FTargetFlowField> FlowFields;
+
+	/** 本帧每个玩家对应的流场下标（对应TargetPawns） */
+	TArray<int32> TargetFlowFields;
+
+	/** 流场共享的导航网格采样缓存 */
+	FSDTANavGrid NavGrid;
+
+	/** 下一帧开始分配寻路预算的敌人下标 */
+	int32 PathRequestCursor;
+
+	/** 本帧跟随流场移动的敌人数量 */
+	int32 FlowFollowerCount;
+};
@@ -0,0 +1,196 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAEnemyRegistry.cpp - 敌人注册表实现文件
+ *
+ * 实现细节：
+ * - 注销时把紧凑数组末尾的敌人移动到被删除的位置，并更新其槽位的紧凑下标
+ * - 槽位代数在注销时递增，已发出的句柄因代数不匹配而失效
+ */
+
+#include "Variant_SDTA/Enemies/SDTAEnemyRegistry.h"
+#include "Variant_SDTA/Enemies/AI/EnemyBase.h"
+
+/**
+ * 注册敌人
+ *
+ * @param Enemy 敌人实例
+ * @return 新分配的句柄，Enemy为空时返回无效句柄
+ */
+FSDTAEnemyHandle FSDTAEnemyRegistry::Add(AEnemyBase* Enemy)
+{
+	if (!Enemy)
+	{
+		return FSDTAEnemyHandle();
+	}
+
+	if (Contains(Enemy))
+	{
+		return Enemy->GetRegistryHandle();
+	}
+
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = Enemies.Add(Enemy);
+	DenseToSlot.Add(SlotIndex);
+
+	const FSDTAEnemyHandle Handle(SlotIndex, Slot.Generation);
+	Enemy->SetRegistryHandle(Handle);
+	return Handle;
+}
+
+/**
+ * 按句柄注销敌人
+ *
+ * @param Handle 敌人句柄
+ * @return 句柄有效且已注销时返回true
+ */
+bool FSDTAEnemyRegistry::Remove(const FSDTAEnemyHandle& Handle)
+{
+	if (!Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return false;
+	}
+
+	const FSlot& Slot = Slots[Handle.SlotIndex];
+	if (Slot.Generation != Handle.Generation || Slot.DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveAtDense(Slot.DenseIndex);
+	return true;
+}
+
+/**
+ * 按指针注销敌人
+ *
+ * @param Enemy 敌人实例
+ * @return 敌人已注册且已注销时返回true
+ */
+bool FSDTAEnemyRegistry::Remove(AEnemyBase* Enemy)
+{
+	if (!Contains(Enemy))
+	{
+		return false;
+	}
+
+	return Remove(Enemy->GetRegistryHandle());
+}
+
+/**
+ * 将句柄解析为敌人
+ *
+ * @param Handle 敌人句柄
+ * @return 句柄仍然有效时返回敌人，否则返回nullptr
+ */
+AEnemyBase* FSDTAEnemyRegistry::Resolve(const FSDTAEnemyHandle& Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return nullptr;
+	}
+
+	const FSlot& Slot = Slots[Handle.SlotIndex];
+	if (Slot.Generation != Handle.Generation || Slot.DenseIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return Enemies[Slot.DenseIndex];
+}
+
+/**
+ * 敌人是否已注册
+ *
+ * @param Enemy 敌人实例
+ * @return 敌人上保存的句柄能解析回该敌人时返回true
+ */
+bool FSDTAEnemyRegistry::Contains(const AEnemyBase* Enemy) const
+{
+	return Enemy && Resolve(Enemy->GetRegistryHandle()) == Enemy;
+}
+
+/**
+ * 注销所有无效的敌人
+ *
+ * 功能：倒序遍历紧凑数组，交换删除空指针和正在销毁的敌人
+ * 设计要点：倒序遍历时，交换到当前位置的末尾元素已经检查过，一次遍历即可完成
+ *
+ * @return 注销的敌人数量
+ */
+int32 FSDTAEnemyRegistry::RemoveInvalid()
+{
+	int32 RemovedCount = 0;
+	for (int32 DenseIndex = Enemies.Num() - 1; DenseIndex >= 0; --DenseIndex)
+	{
+		const AEnemyBase* Enemy = Enemies[DenseIndex];
+		if (!IsValid(Enemy) || Enemy->IsActorBeingDestroyed())
+		{
+			RemoveAtDense(DenseIndex);
+			RemovedCount++;
+		}
+	}
+
+	return RemovedCount;
+}
+
+/**
+ * 注销所有敌人
+ *
+ * 功能：清空紧凑数组，所有槽位代数递增后放回空闲链表
+ */
+void FSDTAEnemyRegistry::Reset()
+{
+	FreeSlots.Reset(Slots.Num());
+	for (int32 SlotIndex = Slots.Num() - 1; SlotIndex >= 0; --SlotIndex)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		if (Slot.DenseIndex != INDEX_NONE)
+		{
+			Slot.DenseIndex = INDEX_NONE;
+			Slot.Generation++;
+		}
+		FreeSlots.Add(SlotIndex);
+	}
+
+	Enemies.Reset();
+	DenseToSlot.Reset();
+}
+
+/**
+ * 注销紧凑下标处的敌人
+ *
+ * @param DenseIndex 紧凑数组下标
+ */
+void FSDTAEnemyRegistry::RemoveAtDense(int32 DenseIndex)
+{
+	const int32 SlotIndex = DenseToSlot[DenseIndex];
+	const int32 LastIndex = Enemies.Num() - 1;
+
+	// 将末尾敌人移动到被删除的位置
+	if (DenseIndex != LastIndex)
+	{
+		const int32 LastSlotIndex = DenseToSlot[LastIndex];
+		Enemies[DenseIndex] = Enemies[LastIndex];
+		DenseToSlot[DenseIndex] = LastSlotIndex;
+		Slots[LastSlotIndex].DenseIndex = DenseIndex;
+	}
+
+	Enemies.Pop(EAllowShrinking::No);
+	DenseToSlot.Pop(EAllowShrinking::No);
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = INDEX_NONE;
+	Slot.Generation++;
+	FreeSlots.Add(SlotIndex);
+}
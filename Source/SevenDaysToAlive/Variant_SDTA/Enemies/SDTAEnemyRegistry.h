@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SDTAEnemyRegistry.generated.h"
+
+class AEnemyBase;
+
+/**
+ * 敌人句柄
+ *
+ * 由敌人注册表分配，槽位索引 + 代数
+ * 敌人注销（死亡、回收）后槽位代数递增，旧句柄随之失效；同一个池化敌人再次生成时会得到新句柄，
+ * 因此其他系统可以安全地长期持有句柄，而不会误指向复用后的敌人
+ */
+USTRUCT(BlueprintType)
+struct SEVENDAYSTOALIVE_API FSDTAEnemyHandle
+{
+	GENERATED_BODY()
+
+	int32 SlotIndex = INDEX_NONE; // 注册表槽位索引
+	uint32 Generation = 0; // 槽位代数
+
+	FSDTAEnemyHandle() {}
+	FSDTAEnemyHandle(int32 InSlotIndex, uint32 InGeneration)
+		: SlotIndex(InSlotIndex), Generation(InGeneration) {}
+
+	/** 句柄是否指向某个槽位（不保证该槽位仍处于同一代） */
+	bool IsValid() const { return SlotIndex != INDEX_NONE; }
+
+	/** 重置为无效句柄 */
+	void Invalidate() { *this = FSDTAEnemyHandle(); }
+
+	bool operator==(const FSDTAEnemyHandle& Other) const
+	{
+		return SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+	}
+	bool operator!=(const FSDTAEnemyHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FSDTAEnemyHandle& Handle)
+	{
+		return HashCombine(GetTypeHash(Handle.SlotIndex), GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * 敌人注册表
+ *
+ * 核心功能：
+ * 1. 以紧凑数组保存所有活跃敌人，遍历时连续访问
+ * 2. 注册、注销、按句柄查找都是O(1)：注销时将末尾敌人交换到被删除的位置
+ * 3. 分配代数句柄，并写回敌人（AEnemyBase::GetRegistryHandle），按指针注销时无需查找
+ *
+ * 设计要点：
+ * - 槽位数组（稀疏）保存每个句柄对应的紧凑下标和代数，空闲槽位通过空闲链表复用
+ * - 紧凑数组的顺序在注销后会改变，遍历过程中注销敌人应使用RemoveInvalid或倒序遍历
+ * - 作为UPROPERTY成员持有时，紧凑数组中的敌人指针受GC追踪
+ */
+USTRUCT()
+struct SEVENDAYSTOALIVE_API FSDTAEnemyRegistry
+{
+	GENERATED_BODY()
+
+	/**
+	 * 注册敌人
+	 *
+	 * @param Enemy 敌人实例（已注册的敌人直接返回现有句柄）
+	 * @return 新分配的句柄
+	 */
+	FSDTAEnemyHandle Add(AEnemyBase* Enemy);
+
+	/**
+	 * 按句柄注销敌人（交换删除）
+	 *
+	 * @param Handle 敌人句柄
+	 * @return 句柄有效且已注销时返回true
+	 */
+	bool Remove(const FSDTAEnemyHandle& Handle);
+
+	/**
+	 * 按指针注销敌人，使用敌人上保存的句柄，无需查找
+	 *
+	 * @param Enemy 敌人实例
+	 * @return 敌人已注册且已注销时返回true
+	 */
+	bool Remove(AEnemyBase* Enemy);
+
+	/**
+	 * 将句柄解析为敌人
+	 *
+	 * @param Handle 敌人句柄
+	 * @return 句柄仍然有效时返回敌人，否则返回nullptr
+	 */
+	AEnemyBase* Resolve(const FSDTAEnemyHandle& Handle) const;
+
+	/** 敌人是否已注册 */
+	bool Contains(const AEnemyBase* Enemy) const;
+
+	/**
+	 * 注销所有无效（已被销毁或正在销毁）的敌人
+	 *
+	 * @return 注销的敌人数量
+	 */
+	int32 RemoveInvalid();
+
+	/** 注销所有敌人，所有已分配的句柄失效 */
+	void Reset();
+
+	/** 活跃敌人数量 */
+	int32 Num() const { return Enemies.Num(); }
+
+	/** 紧凑排列的活跃敌人，只读 */
+	const TArray<AEnemyBase*>& GetEnemies() const { return Enemies; }
+
+	/** 支持ranged-for遍历 */
+	auto begin() const { return Enemies.begin(); }
+	auto end() const { return Enemies.end(); }
+
+private:
+	/** 注销紧凑下标处的敌人（交换删除），并使其槽位失效 */
+	void RemoveAtDense(int32 DenseIndex);
+
+	/**
+	 * 槽位（稀疏）
+	 */
+	struct FSlot
+	{
+		int32 DenseIndex = INDEX_NONE; // 在紧凑数组中的下标，空闲时为INDEX_NONE
+		uint32 Generation = 0; // 槽位代数，每次注销时递增
+	};
+
+	/** 紧凑排列的活跃敌人 */
+	UPROPERTY()
+	TArray<AEnemyBase*> Enemies;
+
+	/** 紧凑下标到槽位索引的映射（与Enemies一一对应） */
+	TArray<int32> DenseToSlot;
+
+	/** 槽位数组 */
+	TArray<FSlot> Slots;
+
+	/** 空闲槽位索引 */
+	TArray<int32> FreeSlots;
+};
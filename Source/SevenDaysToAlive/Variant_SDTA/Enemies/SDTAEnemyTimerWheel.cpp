@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAEnemyTimerWheel.cpp - 敌人定时器时间轮实现文件
+ *
+ * 实现细节：
+ * - 一帧跨越多个刻度时依次处理每个刻度；跨越超过一圈时每个槽位只处理一次
+ * - 处理槽位时原地压缩数组：到期和失效的条目移出，未到期的条目保留，不释放槽位内存
+ */
+
+#include "Variant_SDTA/Enemies/SDTAEnemyTimerWheel.h"
+#include "Variant_SDTA/Enemies/AI/EnemyBase.h"
+
+/**
+ * 设置定时器
+ *
+ * 功能：递增序号使同类型的旧条目失效，再把新条目追加到到期时间之后的第一个刻度对应的槽位
+ *
+ * @param Enemy 敌人
+ * @param Timer 定时器类型
+ * @param Now 当前世界时间
+ * @param Delay 延迟（秒）
+ */
+void FSDTAEnemyTimerWheel::Schedule(AEnemyBase* Enemy, ESDTAEnemyTimer Timer, double Now, float Delay)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	const int32 TimerIndex = static_cast<int32>(Timer);
+	FSDTAEnemyTimerState& State = Enemy->TimerState;
+	State.Serials[TimerIndex]++;
+	State.ActiveMask |= static_cast<uint8>(1 << TimerIndex);
+
+	FEntry Entry;
+	Entry.Enemy = Enemy;
+	Entry.FireTime = Now + FMath::Max(Delay, 0.0f);
+	Entry.Serial = State.Serials[TimerIndex];
+	Entry.Timer = Timer;
+
+	if (LastProcessedTick == INDEX_NONE)
+	{
+		LastProcessedTick = FMath::FloorToInt64(Now / Resolution) - 1;
+	}
+
+	// 放入到期时间之后的第一个刻度，且不早于下一个待处理的刻度
+	const int64 Tick = FMath::Max(FMath::CeilToInt64(Entry.FireTime / Resolution), LastProcessedTick + 1);
+	Slots[Tick % SlotCount].Add(Entry);
+	PendingCount++;
+}
+
+/**
+ * 取消定时器
+ *
+ * @param Enemy 敌人
+ * @param Timer 定时器类型
+ */
+void FSDTAEnemyTimerWheel::Cancel(AEnemyBase* Enemy, ESDTAEnemyTimer Timer)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	const int32 TimerIndex = static_cast<int32>(Timer);
+	FSDTAEnemyTimerState& State = Enemy->TimerState;
+	if (State.ActiveMask & (1 << TimerIndex))
+	{
+		State.Serials[TimerIndex]++;
+		State.ActiveMask &= static_cast<uint8>(~(1 << TimerIndex));
+	}
+}
+
+bool FSDTAEnemyTimerWheel::IsActive(const AEnemyBase* Enemy, ESDTAEnemyTimer Timer)
+{
+	return Enemy && (Enemy->TimerState.ActiveMask & (1 << static_cast<int32>(Timer))) != 0;
+}
+
+/**
+ * 推进时间轮，触发所有到期的定时器
+ *
+ * @param Now 当前世界时间
+ * @return 触发的定时器数量
+ */
+int32 FSDTAEnemyTimerWheel::Advance(double Now)
+{
+	const int64 CurrentTick = FMath::FloorToInt64(Now / Resolution);
+	if (LastProcessedTick == INDEX_NONE)
+	{
+		LastProcessedTick = CurrentTick;
+		return 0;
+	}
+
+	if (PendingCount == 0)
+	{
+		LastProcessedTick = FMath::Max(LastProcessedTick, CurrentTick);
+		return 0;
+	}
+
+	Fired.Reset();
+
+	// 跨越超过一圈时每个槽位只需处理一次
+	const int64 FirstTick = FMath::Max(LastProcessedTick + 1, CurrentTick - SlotCount + 1);
+	for (int64 Tick = FirstTick; Tick <= CurrentTick; ++Tick)
+	{
+		TArray<FEntry>& Slot = Slots[Tick % SlotCount];
+
+		int32 Kept = 0;
+		for (int32 Index = 0; Index < Slot.Num(); ++Index)
+		{
+			FEntry& Entry = Slot[Index];
+			AEnemyBase* Enemy = nullptr;
+			if (!IsCurrent(Entry, Enemy))
+			{
+				continue;
+			}
+
+			if (Entry.FireTime <= Now)
+			{
+				Fired.Add(Entry);
+				continue;
+			}
+
+			// 超过一圈的条目留到下一圈
+			if (Kept != Index)
+			{
+				Slot[Kept] = MoveTemp(Entry);
+			}
+			Kept++;
+		}
+
+		PendingCount -= Slot.Num() - Kept;
+		Slot.SetNum(Kept, EAllowShrinking::No);
+	}
+
+	LastProcessedTick = FMath::Max(LastProcessedTick, CurrentTick);
+
+	// 按到期时间顺序回调，回调中设置的新定时器只会进入之后的刻度
+	Fired.Sort([](const FEntry& A, const FEntry& B) { return A.FireTime < B.FireTime; });
+
+	int32 FiredCount = 0;
+	for (const FEntry& Entry : Fired)
+	{
+		// 同一批中较早的回调可能已经取消了这个定时器
+		AEnemyBase* Enemy = nullptr;
+		if (!IsCurrent(Entry, Enemy))
+		{
+			continue;
+		}
+
+		Enemy->TimerState.ActiveMask &= static_cast<uint8>(~(1 << static_cast<int32>(Entry.Timer)));
+		Enemy->OnEnemyTimerFired(Entry.Timer);
+		FiredCount++;
+	}
+
+	return FiredCount;
+}
+
+/**
+ * 清空时间轮
+ */
+void FSDTAEnemyTimerWheel::Reset()
+{
+	for (TArray<FEntry>& Slot : Slots)
+	{
+		Slot.Reset();
+	}
+
+	Fired.Reset();
+	LastProcessedTick = INDEX_NONE;
+	PendingCount = 0;
+}
+
+/**
+ * 条目是否仍然有效
+ *
+ * @param Entry 条目
+ * @param OutEnemy 输出：有效时为条目对应的敌人
+ * @return 敌人存在且序号一致时返回true
+ */
+bool FSDTAEnemyTimerWheel::IsCurrent(const FEntry& Entry, AEnemyBase*& OutEnemy)
+{
+	OutEnemy = Entry.Enemy.Get();
+	return OutEnemy && OutEnemy->TimerState.Serials[static_cast<int32>(Entry.Timer)] == Entry.Serial;
+}
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AEnemyBase;
+
+/**
+ * 敌人定时器类型
+ */
+enum class ESDTAEnemyTimer : uint8
+{
+	HitAnimation,   // 受击动画完成
+	DeathAnimation, // 死亡动画完成
+	AttackCooldown, // 攻击冷却结束
+
+	Count
+};
+
+/**
+ * 敌人定时器状态（保存在每个敌人上）
+ *
+ * 每种定时器一个序号：设置和取消定时器时序号递增，时间轮中序号不一致的条目视为已取消，
+ * 取消定时器因此不需要在时间轮中查找和删除条目
+ */
+struct FSDTAEnemyTimerState
+{
+	uint32 Serials[static_cast<int32>(ESDTAEnemyTimer::Count)] = {}; // 每种定时器的当前序号
+	uint8 ActiveMask = 0; // 正在计时的定时器位掩码
+};
+
+/**
+ * 敌人定时器时间轮
+ *
+ * 核心功能：
+ * 1. 替代每个敌人各自向FTimerManager注册的受击/死亡动画和攻击冷却定时器
+ * 2. 由USDTAEnemyManager每帧推进一次，在一次遍历中处理所有到期的定时器
+ *
+ * 设计要点：
+ * - 时间按Resolution划分为刻度，每个刻度对应SlotCount个槽位之一；设置定时器只是向槽位数组末尾追加条目
+ * - 条目放入到期时间之后的第一个刻度，处理该刻度时一定已经到期；超过一圈的条目留在槽位中等下一圈
+ * - 取消采用惰性方式：递增敌人上的序号，条目在处理槽位时被丢弃
+ * - 敌人以弱指针保存，敌人被销毁后条目自动失效
+ * - 到期的条目先收集再回调，回调中可以安全地设置新的定时器
+ */
+class SEVENDAYSTOALIVE_API FSDTAEnemyTimerWheel
+{
+public:
+	/** 槽位数量 */
+	static constexpr int32 SlotCount = 256;
+
+	/** 每个刻度的时长（秒） */
+	static constexpr double Resolution = 1.0 / 30.0;
+
+	/**
+	 * 设置定时器（同类型的旧定时器被替换）
+	 *
+	 * @param Enemy 敌人
+	 * @param Timer 定时器类型
+	 * @param Now 当前世界时间
+	 * @param Delay 延迟（秒）
+	 */
+	void Schedule(AEnemyBase* Enemy, ESDTAEnemyTimer Timer, double Now, float Delay);
+
+	/**
+	 * 取消定时器
+	 *
+	 * @param Enemy 敌人
+	 * @param Timer 定时器类型
+	 */
+	static void Cancel(AEnemyBase* Enemy, ESDTAEnemyTimer Timer);
+
+	/** 定时器是否正在计时 */
+	static bool IsActive(const AEnemyBase* Enemy, ESDTAEnemyTimer Timer);
+
+	/**
+	 * 推进时间轮，触发所有到期的定时器
+	 *
+	 * @param Now 当前世界时间
+	 * @return 触发的定时器数量
+	 */
+	int32 Advance(double Now);
+
+	/** 时间轮中的条目数量（含已取消但尚未清理的条目） */
+	int32 GetPendingCount() const { return PendingCount; }
+
+	/** 清空时间轮 */
+	void Reset();
+
+private:
+	/** 时间轮条目 */
+	struct FEntry
+	{
+		TWeakObjectPtr<AEnemyBase> Enemy; // 敌人
+		double FireTime = 0.0; // 到期时间
+		uint32 Serial = 0; // 设置时的序号
+		ESDTAEnemyTimer Timer = ESDTAEnemyTimer::HitAnimation; // 定时器类型
+	};
+
+	/** 条目是否仍然有效（敌人存在且未被取消或替换） */
+	static bool IsCurrent(const FEntry& Entry, AEnemyBase*& OutEnemy);
+
+	/** 槽位 */
+	TArray<FEntry> Slots[SlotCount];
+
+	/** 本帧到期的条目 */
+	TArray<FEntry> Fired;
+
+	/** 最后处理的刻度，INDEX_NONE表示尚未推进过 */
+	int64 LastProcessedTick = INDEX_NONE;
+
+	/** 条目数量 */
+	int32 PendingCount = 0;
+};
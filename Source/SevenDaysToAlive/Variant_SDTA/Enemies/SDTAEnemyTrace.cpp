@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTAEnemyTrace.cpp - 敌人AI追踪实现文件
+ *
+ * 实现细节：
+ * - 每个敌人的记录保存在定长数组中，写满后覆盖最旧的记录，不分配额外内存
+ * - 记录按敌人UniqueID保存在映射表中，对象池复用的敌人沿用同一个环形缓冲区
+ * - Test/Shipping构建中只保留空函数和日志分类定义
+ */
+
+#include "Variant_SDTA/Enemies/SDTAEnemyTrace.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogSDTAEnemy);
+
+#if SDTA_ENEMY_TRACE_ENABLED
+
+namespace SDTAEnemyTrace
+{
+	static int32 GEnabled = 0;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("sdta.Enemy.Trace"),
+		GEnabled,
+		TEXT("开关敌人AI追踪（0：关闭，1：开启）"));
+
+	static int32 GSampleRate = 1;
+	static FAutoConsoleVariableRef CVarSampleRate(
+		TEXT("sdta.Enemy.TraceSampleRate"),
+		GSampleRate,
+		TEXT("每N个敌人追踪一个（按敌人UniqueID取模）"));
+
+	static int32 GLogEvents = 0;
+	static FAutoConsoleVariableRef CVarLogEvents(
+		TEXT("sdta.Enemy.TraceLog"),
+		GLogEvents,
+		TEXT("记录追踪事件时同时以Verbose级别输出到LogSDTAEnemy"));
+
+	/** 一条追踪记录 */
+	struct FEntry
+	{
+		double Time = 0.0; // 世界时间
+		FVector3f Location = FVector3f::ZeroVector; // 敌人位置
+		float Value = 0.0f; // 事件附带的数值
+		ESDTAEnemyTraceEvent Event = ESDTAEnemyTraceEvent::Spawned; // 事件
+	};
+
+	/** 单个敌人的环形缓冲区 */
+	struct FRing
+	{
+		FEntry Entries[FSDTAEnemyTrace::EntriesPerEnemy];
+		int32 Head = 0; // 下一条记录的写入位置
+		int32 Count = 0; // 有效记录数量
+
+		void Push(const FEntry& Entry)
+		{
+			Entries[Head] = Entry;
+			Head = (Head + 1) % FSDTAEnemyTrace::EntriesPerEnemy;
+			Count = FMath::Min(Count + 1, FSDTAEnemyTrace::EntriesPerEnemy);
+		}
+	};
+
+	/** 敌人UniqueID到环形缓冲区的映射 */
+	static TMap<uint32, FRing> GRings;
+
+	/** 按时间顺序输出一个敌人的记录 */
+	static void DumpRing(uint32 EnemyId, const FRing& Ring)
+	{
+		UE_LOG(LogSDTAEnemy, Log, TEXT("[SDTAEnemyTrace] 敌人 %u：%d 条记录"), EnemyId, Ring.Count);
+
+		const int32 First = (Ring.Head - Ring.Count + FSDTAEnemyTrace::EntriesPerEnemy) % FSDTAEnemyTrace::EntriesPerEnemy;
+		for (int32 Offset = 0; Offset < Ring.Count; ++Offset)
+		{
+			const FEntry& Entry = Ring.Entries[(First + Offset) % FSDTAEnemyTrace::EntriesPerEnemy];
+			UE_LOG(LogSDTAEnemy, Log, TEXT("  %9.3f  %-12s  %8.1f  (%.0f, %.0f, %.0f)"),
+			       Entry.Time, FSDTAEnemyTrace::GetEventName(Entry.Event), Entry.Value,
+			       Entry.Location.X, Entry.Location.Y, Entry.Location.Z);
+		}
+	}
+
+	static FAutoConsoleCommand CmdDump(
+		TEXT("sdta.Enemy.DumpTrace"),
+		TEXT("输出敌人AI追踪记录。参数：[敌人UniqueID]，省略时输出全部"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FSDTAEnemyTrace::Dump(Args.Num() > 0 ? static_cast<uint32>(FCString::Atoi64(*Args[0])) : 0);
+		}));
+
+	static FAutoConsoleCommand CmdReset(
+		TEXT("sdta.Enemy.ResetTrace"),
+		TEXT("清空敌人AI追踪记录"),
+		FConsoleCommandDelegate::CreateStatic(&FSDTAEnemyTrace::Reset));
+}
+
+/**
+ * 记录一次状态转换
+ *
+ * 功能：追踪关闭或敌人未被采样时直接返回；否则写入该敌人的环形缓冲区
+ *
+ * @param Enemy 敌人
+ * @param Event 事件
+ * @param Value 事件附带的数值
+ */
+void FSDTAEnemyTrace::Record(const AActor* Enemy, ESDTAEnemyTraceEvent Event, float Value)
+{
+	using namespace SDTAEnemyTrace;
+
+	if (!GEnabled || !Enemy)
+	{
+		return;
+	}
+
+	const uint32 EnemyId = Enemy->GetUniqueID();
+	if (GSampleRate > 1 && EnemyId % static_cast<uint32>(GSampleRate) != 0)
+	{
+		return;
+	}
+
+	FRing* Ring = GRings.Find(EnemyId);
+	if (!Ring)
+	{
+		if (GRings.Num() >= MaxTracedEnemies)
+		{
+			return;
+		}
+		Ring = &GRings.Add(EnemyId);
+	}
+
+	FEntry Entry;
+	Entry.Time = Enemy->GetWorld() ? Enemy->GetWorld()->GetTimeSeconds() : 0.0;
+	Entry.Location = FVector3f(Enemy->GetActorLocation());
+	Entry.Value = Value;
+	Entry.Event = Event;
+	Ring->Push(Entry);
+
+	if (GLogEvents)
+	{
+		UE_LOG(LogSDTAEnemy, Verbose, TEXT("[SDTAEnemyTrace] 敌人 %u %s %.1f"), EnemyId, GetEventName(Event), Value);
+	}
+}
+
+/**
+ * 输出追踪记录到LogSDTAEnemy
+ *
+ * @param EnemyId 敌人UniqueID，0表示输出全部
+ */
+void FSDTAEnemyTrace::Dump(uint32 EnemyId)
+{
+	using namespace SDTAEnemyTrace;
+
+	if (EnemyId != 0)
+	{
+		if (const FRing* Ring = GRings.Find(EnemyId))
+		{
+			DumpRing(EnemyId, *Ring);
+		}
+		else
+		{
+			UE_LOG(LogSDTAEnemy, Log, TEXT("[SDTAEnemyTrace] 敌人 %u 没有追踪记录"), EnemyId);
+		}
+		return;
+	}
+
+	UE_LOG(LogSDTAEnemy, Log, TEXT("[SDTAEnemyTrace] 共追踪 %d 个敌人"), GRings.Num());
+	for (const TPair<uint32, FRing>& Pair : GRings)
+	{
+		DumpRing(Pair.Key, Pair.Value);
+	}
+}
+
+/**
+ * 清空追踪记录
+ */
+void FSDTAEnemyTrace::Reset()
+{
+	SDTAEnemyTrace::GRings.Reset();
+}
+
+#else
+
+void FSDTAEnemyTrace::Record(const AActor* Enemy, ESDTAEnemyTraceEvent Event, float Value) {}
+void FSDTAEnemyTrace::Dump(uint32 EnemyId) {}
+void FSDTAEnemyTrace::Reset() {}
+
+#endif // SDTA_ENEMY_TRACE_ENABLED
+
+/**
+ * 事件名称
+ *
+ * @param Event 事件
+ * @return 事件名称
+ */
+const TCHAR* FSDTAEnemyTrace::GetEventName(ESDTAEnemyTraceEvent Event)
+{
+	switch (Event)
+	{
+	case ESDTAEnemyTraceEvent::Spawned:      return TEXT("Spawned");
+	case ESDTAEnemyTraceEvent::Released:     return TEXT("Released");
+	case ESDTAEnemyTraceEvent::ChaseFailed:  return TEXT("ChaseFailed");
+	case ESDTAEnemyTraceEvent::PathRequest:  return TEXT("PathRequest");
+	case ESDTAEnemyTraceEvent::FlowFollow:   return TEXT("FlowFollow");
+	case ESDTAEnemyTraceEvent::Attack:       return TEXT("Attack");
+	case ESDTAEnemyTraceEvent::AttackFailed: return TEXT("AttackFailed");
+	case ESDTAEnemyTraceEvent::AttackReady:  return TEXT("AttackReady");
+	case ESDTAEnemyTraceEvent::TierChanged:  return TEXT("TierChanged");
+	default:                                 return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 敌人日志分类 */
+DECLARE_LOG_CATEGORY_EXTERN(LogSDTAEnemy, Log, All);
+
+/** 敌人AI追踪是否编译进当前构建（Test/Shipping中整体移除） */
+#ifndef SDTA_ENEMY_TRACE_ENABLED
+	#define SDTA_ENEMY_TRACE_ENABLED !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+/**
+ * 敌人AI追踪事件
+ */
+enum class ESDTAEnemyTraceEvent : uint8
+{
+	Spawned,        // 从对象池借出或放置到场景中
+	Released,       // 回收到对象池
+	ChaseFailed,    // 追逐失败（无目标或已死亡），Value无意义
+	PathRequest,    // 单独寻路请求，Value为到目标的距离
+	FlowFollow,     // 开始跟随流场，Value为到目标的距离
+	Attack,         // 发起攻击，Value为攻击冷却时间
+	AttackFailed,   // 攻击条件不满足
+	AttackReady,    // 攻击冷却结束
+	TierChanged,    // 重要性等级变化，Value为新等级
+};
+
+/**
+ * 敌人AI追踪
+ *
+ * 核心功能：
+ * 1. 为每个被采样的敌人保存一个定长环形缓冲区，记录最近的状态转换（时间、事件、数值、位置）
+ * 2. 记录时只写入结构体，不格式化字符串；需要排查时用控制台命令 sdta.Enemy.DumpTrace 一次性输出
+ *
+ * 设计要点：
+ * - 只记录状态转换（开始追逐、寻路、攻击、换级等），不在每帧调用
+ * - 按敌人UniqueID取模采样（sdta.Enemy.TraceSampleRate），被采样的敌人记录完整，便于还原单个敌人的行为
+ * - 通过SDTA_ENEMY_TRACE宏调用，Test/Shipping构建中宏展开为空，参数也不会求值
+ * - 只在游戏线程上使用
+ *
+ * 控制台变量/命令：
+ * - sdta.Enemy.Trace 0/1：开关追踪（默认关闭）
+ * - sdta.Enemy.TraceSampleRate N：每N个敌人追踪一个
+ * - sdta.Enemy.TraceLog 0/1：记录时同时以Verbose级别输出到LogSDTAEnemy
+ * - sdta.Enemy.DumpTrace [敌人ID]：输出全部或指定敌人的追踪记录
+ * - sdta.Enemy.ResetTrace：清空追踪记录
+ */
+class SEVENDAYSTOALIVE_API FSDTAEnemyTrace
+{
+public:
+	/** 每个敌人保留的记录数量 */
+	static constexpr int32 EntriesPerEnemy = 16;
+
+	/** 最多追踪的敌人数量 */
+	static constexpr int32 MaxTracedEnemies = 512;
+
+	/**
+	 * 记录一次状态转换
+	 *
+	 * @param Enemy 敌人
+	 * @param Event 事件
+	 * @param Value 事件附带的数值
+	 */
+	static void Record(const AActor* Enemy, ESDTAEnemyTraceEvent Event, float Value = 0.0f);
+
+	/**
+	 * 输出追踪记录到LogSDTAEnemy
+	 *
+	 * @param EnemyId 敌人UniqueID，0表示输出全部
+	 */
+	static void Dump(uint32 EnemyId = 0);
+
+	/** 清空追踪记录 */
+	static void Reset();
+
+	/** 事件名称 */
+	static const TCHAR* GetEventName(ESDTAEnemyTraceEvent Event);
+};
+
+#if SDTA_ENEMY_TRACE_ENABLED
+	#define SDTA_ENEMY_TRACE(Enemy, Event, ...) FSDTAEnemyTrace::Record((Enemy), ESDTAEnemyTraceEvent::Event, ##__VA_ARGS__)
+#else
+	#define SDTA_ENEMY_TRACE(Enemy, Event, ...)
+#endif
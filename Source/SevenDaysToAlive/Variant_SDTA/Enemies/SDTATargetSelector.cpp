@@ -0,0 +1,230 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * SDTATargetSelector.cpp - 敌人目标选择器实现文件
+ *
+ * 实现细节：
+ * - 第R圈格子与查询点的最小距离不小于(R - 1) × CellSize，据此提前结束逐圈搜索
+ * - 搜索圈数不超过已占用格子范围，远离所有玩家的敌人也不会无限向外搜索
+ */
+
+#include "Variant_SDTA/Enemies/SDTATargetSelector.h"
+
+/**
+ * 清空所有目标并设置空间索引的格子尺寸
+ *
+ * @param InCellSize 格子边长（cm）
+ */
+void FSDTATargetSelector::Reset(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 100.0f);
+	Targets.Reset();
+	Buckets.Reset();
+	TotalAssigned = 0;
+}
+
+/**
+ * 添加目标
+ *
+ * @param Location 目标位置
+ * @param ThreatMultiplier 威胁系数（越大越容易被选中）
+ * @return 目标下标
+ */
+int32 FSDTATargetSelector::AddTarget(const FVector& Location, float ThreatMultiplier)
+{
+	FTarget& Target = Targets.AddDefaulted_GetRef();
+	Target.Location = Location;
+	Target.ThreatMultiplier = FMath::Max(ThreatMultiplier, KINDA_SMALL_NUMBER);
+	return Targets.Num() - 1;
+}
+
+/**
+ * 构建空间索引
+ */
+void FSDTATargetSelector::BuildIndex()
+{
+	Buckets.Reset();
+
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		const FIntPoint Cell = ToCell(Targets[TargetIndex].Location);
+		Buckets.FindOrAdd(Cell).Add(TargetIndex);
+
+		if (TargetIndex == 0)
+		{
+			MinCell = MaxCell = Cell;
+		}
+		else
+		{
+			MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+			MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+		}
+	}
+}
+
+/**
+ * 查找最近的目标
+ *
+ * 功能：从查询点所在格子开始逐圈搜索，找到的最近距离小于下一圈的最小距离时停止
+ *
+ * @param Location 查询位置
+ * @param OutDistSq 输出：到最近目标的距离平方
+ * @return 最近目标的下标，没有目标时返回INDEX_NONE
+ */
+int32 FSDTATargetSelector::FindNearest(const FVector& Location, float& OutDistSq) const
+{
+	OutDistSq = TNumericLimits<float>::Max();
+	if (Targets.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// 目标很少时直接遍历比逐圈搜索更快
+	if (Targets.Num() <= 2)
+	{
+		int32 BestTarget = INDEX_NONE;
+		for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+		{
+			const float DistSq = FVector::DistSquared(Location, Targets[TargetIndex].Location);
+			if (DistSq < OutDistSq)
+			{
+				OutDistSq = DistSq;
+				BestTarget = TargetIndex;
+			}
+		}
+		return BestTarget;
+	}
+
+	const FIntPoint Center = ToCell(Location);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(Center.X - MinCell.X), FMath::Abs(Center.X - MaxCell.X)),
+		FMath::Max(FMath::Abs(Center.Y - MinCell.Y), FMath::Abs(Center.Y - MaxCell.Y)));
+
+	int32 BestTarget = INDEX_NONE;
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// 该圈格子与查询点的最小距离已超过当前最近距离
+		if (BestTarget != INDEX_NONE && FMath::Square((Ring - 1) * CellSize) > OutDistSq)
+		{
+			break;
+		}
+
+		for (int32 Y = -Ring; Y <= Ring; ++Y)
+		{
+			// 只访问该圈的边界格子
+			const int32 StepX = (Y == -Ring || Y == Ring) ? 1 : FMath::Max(Ring * 2, 1);
+			for (int32 X = -Ring; X <= Ring; X += StepX)
+			{
+				const TArray<int32, TInlineAllocator<4>>* Bucket = Buckets.Find(Center + FIntPoint(X, Y));
+				if (!Bucket)
+				{
+					continue;
+				}
+
+				for (int32 TargetIndex : *Bucket)
+				{
+					const float DistSq = FVector::DistSquared(Location, Targets[TargetIndex].Location);
+					if (DistSq < OutDistSq)
+					{
+						OutDistSq = DistSq;
+						BestTarget = TargetIndex;
+					}
+				}
+			}
+		}
+	}
+
+	return BestTarget;
+}
+
+/**
+ * 按距离、威胁和拥挤程度选择目标
+ *
+ * @param Location 敌人位置
+ * @param CurrentTarget 当前目标下标，没有时为INDEX_NONE
+ * @param CrowdingWeight 拥挤权重，0表示只按距离和威胁选择
+ * @param SwitchHysteresis 切换目标所需的最小评分优势（0~1）
+ * @return 选中的目标下标，没有目标时返回INDEX_NONE
+ */
+int32 FSDTATargetSelector::SelectTarget(const FVector& Location, int32 CurrentTarget, float CrowdingWeight, float SwitchHysteresis) const
+{
+	if (Targets.Num() <= 1)
+	{
+		return Targets.Num() == 1 ? 0 : INDEX_NONE;
+	}
+
+	const float AverageAssigned = FMath::Max(1.0f, static_cast<float>(TotalAssigned) / Targets.Num());
+
+	int32 BestTarget = INDEX_NONE;
+	float BestScore = TNumericLimits<float>::Max();
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		const float Score = ScoreTarget(TargetIndex, Location, CrowdingWeight, AverageAssigned, TargetIndex == CurrentTarget);
+		if (Score < BestScore)
+		{
+			BestScore = Score;
+			BestTarget = TargetIndex;
+		}
+	}
+
+	// 当前目标的评分与最优目标相差不大时保持不变
+	if (Targets.IsValidIndex(CurrentTarget) && BestTarget != CurrentTarget)
+	{
+		const float CurrentScore = ScoreTarget(CurrentTarget, Location, CrowdingWeight, AverageAssigned, true);
+		if (BestScore > CurrentScore * (1.0f - FMath::Clamp(SwitchHysteresis, 0.0f, 1.0f)))
+		{
+			return CurrentTarget;
+		}
+	}
+
+	return BestTarget;
+}
+
+/**
+ * 更新目标的已分配敌人数量
+ *
+ * @param OldTarget 原目标下标（INDEX_NONE表示无）
+ * @param NewTarget 新目标下标（INDEX_NONE表示无）
+ */
+void FSDTATargetSelector::Reassign(int32 OldTarget, int32 NewTarget)
+{
+	if (OldTarget == NewTarget)
+	{
+		return;
+	}
+
+	if (Targets.IsValidIndex(OldTarget))
+	{
+		Targets[OldTarget].AssignedCount--;
+		TotalAssigned--;
+	}
+
+	if (Targets.IsValidIndex(NewTarget))
+	{
+		Targets[NewTarget].AssignedCount++;
+		TotalAssigned++;
+	}
+}
+
+/**
+ * 目标评分
+ *
+ * @param TargetIndex 目标下标
+ * @param Location 敌人位置
+ * @param CrowdingWeight 拥挤权重
+ * @param AverageAssigned 平均每个目标分配的敌人数量
+ * @param bIsCurrent 是否为敌人的当前目标（计算拥挤程度时不计入自己）
+ * @return 评分，越小越优先
+ */
+float FSDTATargetSelector::ScoreTarget(int32 TargetIndex, const FVector& Location, float CrowdingWeight, float AverageAssigned, bool bIsCurrent) const
+{
+	const FTarget& Target = Targets[TargetIndex];
+	const int32 Assigned = FMath::Max(0, Target.AssignedCount - (bIsCurrent ? 1 : 0));
+	const float Crowding = 1.0f + CrowdingWeight * Assigned / AverageAssigned;
+	return FVector::Dist(Location, Target.Location) * Crowding / Target.ThreatMultiplier;
+}
+
+FIntPoint FSDTATargetSelector::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 敌人目标选择器
+ *
+ * 核心功能：
+ * 1. 每帧把所有存活玩家的位置放入均匀网格（空间索引），按格子由近到远查找最近的玩家
+ * 2. 按距离、威胁系数和已分配敌人数量为敌人选择目标，让敌人分散到多个玩家身上
+ *
+ * 设计要点：
+ * - 最近玩家查询从敌人所在格子向外逐圈搜索，已找到的最近距离小于下一圈的最小距离时停止
+ * - 目标评分 = 距离 × (1 + 拥挤权重 × 已分配数量 / 平均分配数量) / 威胁系数，越小越优先
+ * - 当前目标仍然有效时，只有新目标的评分比当前目标低出一定比例才切换，避免敌人在两个玩家间来回摇摆
+ * - 只保存玩家下标，不持有UObject，由USDTAEnemyManager每帧重建
+ */
+class SEVENDAYSTOALIVE_API FSDTATargetSelector
+{
+public:
+	/**
+	 * 清空所有目标并设置空间索引的格子尺寸
+	 *
+	 * @param InCellSize 格子边长（cm）
+	 */
+	void Reset(float InCellSize);
+
+	/**
+	 * 添加目标
+	 *
+	 * @param Location 目标位置
+	 * @param ThreatMultiplier 威胁系数（越大越容易被选中）
+	 * @return 目标下标
+	 */
+	int32 AddTarget(const FVector& Location, float ThreatMultiplier);
+
+	/** 添加完所有目标后构建空间索引 */
+	void BuildIndex();
+
+	/**
+	 * 查找最近的目标
+	 *
+	 * @param Location 查询位置
+	 * @param OutDistSq 输出：到最近目标的距离平方
+	 * @return 最近目标的下标，没有目标时返回INDEX_NONE
+	 */
+	int32 FindNearest(const FVector& Location, float& OutDistSq) const;
+
+	/**
+	 * 按距离、威胁和拥挤程度选择目标
+	 *
+	 * @param Location 敌人位置
+	 * @param CurrentTarget 当前目标下标，没有时为INDEX_NONE
+	 * @param CrowdingWeight 拥挤权重，0表示只按距离和威胁选择
+	 * @param SwitchHysteresis 切换目标所需的最小评分优势（0~1）
+	 * @return 选中的目标下标，没有目标时返回INDEX_NONE
+	 */
+	int32 SelectTarget(const FVector& Location, int32 CurrentTarget, float CrowdingWeight, float SwitchHysteresis) const;
+
+	/**
+	 * 更新目标的已分配敌人数量
+	 *
+	 * @param OldTarget 原目标下标（INDEX_NONE表示无）
+	 * @param NewTarget 新目标下标（INDEX_NONE表示无）
+	 */
+	void Reassign(int32 OldTarget, int32 NewTarget);
+
+	/** 目标数量 */
+	int32 Num() const { return Targets.Num(); }
+
+	/** 目标位置 */
+	const FVector& GetLocation(int32 TargetIndex) const { return Targets[TargetIndex].Location; }
+
+	/** 分配给目标的敌人数量 */
+	int32 GetAssignedCount(int32 TargetIndex) const { return Targets[TargetIndex].AssignedCount; }
+
+private:
+	/** 目标 */
+	struct FTarget
+	{
+		FVector Location = FVector::ZeroVector; // 位置
+		float ThreatMultiplier = 1.0f; // 威胁系数
+		int32 AssignedCount = 0; // 已分配的敌人数量
+	};
+
+	/** 目标评分（越小越优先） */
+	float ScoreTarget(int32 TargetIndex, const FVector& Location, float CrowdingWeight, float AverageAssigned, bool bIsCurrent) const;
+
+	/** 世界坐标所在的格子 */
+	FIntPoint ToCell(const FVector& Location) const;
+
+	/** 所有目标 */
+	TArray<FTarget> Targets;
+
+	/** 格子到目标下标的映射 */
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Buckets;
+
+	/** 已占用格子的范围 */
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint MaxCell = FIntPoint::ZeroValue;
+
+	/** 已分配的敌人总数 */
+	int32 TotalAssigned = 0;
+
+	/** 格子边长（cm） */
+	float CellSize = 2000.0f;
+};
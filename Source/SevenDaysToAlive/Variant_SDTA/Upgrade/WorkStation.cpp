@@ -247,13 +247,23 @@ void AWorkStation::Reset()
 	SetActorTickEnabled(false);
 }
 
+/**
+ * 从对象池借出回调
+ * 实现ISDTAPoolable，借出时重置工作台状态，由昼夜状态决定何时显示
+ */
+void AWorkStation::OnAcquiredFromPool(const FSDTAPoolHandle& Handle)
+{
+	Reset();
+}
+
 /**
  * 获取对象池管理器实例
+ * 未显式设置时返回所在世界的对象池子系统
  * @return 对象池管理器实例，如果不存在则返回nullptr
  */
 USDTAPoolManager* AWorkStation::GetPoolManager() const
 {
-	return PoolManager;
+	return PoolManager ? PoolManager : USDTAPoolManager::Get(this);
 }
 
 /**
@@ -4,7 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "Variant_SDTA/Core/Pool/SDTAPoolManager.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolableInterface.h"
 #include "WorkStation.generated.h"
 
 class USphereComponent;
@@ -22,7 +22,7 @@ class USDTAPoolManager;
  * 4. 提供交互反馈和视觉效果
  */
 UCLASS()
-class SEVENDAYSTOALIVE_API AWorkStation : public AActor
+class SEVENDAYSTOALIVE_API AWorkStation : public AActor, public ISDTAPoolable
 {
 	GENERATED_BODY()
 	
@@ -58,6 +58,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Pooling")
 	void Reset();
 
+	/** ISDTAPoolable：从对象池借出时重置工作台状态 */
+	virtual void OnAcquiredFromPool(const FSDTAPoolHandle& Handle) override;
+
 	/**
 	 * 获取对象池管理器实例
 	 * @return 对象池管理器实例，如果不存在则返回nullptr
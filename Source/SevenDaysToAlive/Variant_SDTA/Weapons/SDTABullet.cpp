@@ -12,7 +12,7 @@
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
-#include "Core/Pool/SDTAPoolManager.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolManager.h"
 
 ASDTABullet::ASDTABullet()
 {
@@ -33,6 +33,9 @@ ASDTABullet::ASDTABullet()
 	ProjectileMovement->MaxSpeed = GetBulletVelocity();
 	ProjectileMovement->bShouldBounce = false;
 
+	// 弹丸移动由ActivateBullet启动，预热到对象池中的子弹不会自行飞行
+	ProjectileMovement->bAutoActivate = false;
+
 	// 设置默认伤害类型
 	DamageType = UDamageType::StaticClass();
 }
@@ -41,11 +44,8 @@ void ASDTABullet::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	// 忽略发射者
-	CollisionComponent->IgnoreActorWhenMoving(GetInstigator(), true);
-
-	// 设置生命周期定时器
-	GetWorld()->GetTimerManager().SetTimer(LifetimeTimer, this, &ASDTABullet::OnLifetimeEnd, GetBulletLifetime(), false);
+	// 生命周期定时器和发射者忽略在ActivateBullet中设置，
+	// 预热到对象池中的子弹在借出前不会计时
 }
 
 void ASDTABullet::EndPlay(EEndPlayReason::Type EndPlayReason)
@@ -90,8 +90,8 @@ void ASDTABullet::NotifyHit(class UPrimitiveComponent* MyComp, AActor* Other, cl
 		GetWorld()->GetTimerManager().SetTimer(DestructionTimer, this, &ASDTABullet::OnDeferredDestruction, DeferredDestructionTime, false);
 
 	} else {
-		// 立即销毁
-		Destroy();
+		// 立即回收
+		ReturnToPool();
 	}
 }
 
@@ -99,7 +99,10 @@ void ASDTABullet::ActivateBullet(const FVector& Direction)
 {
 	// 重置状态
 	bHit = false;
-	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+	// 忽略发射者（池化子弹每次借出的发射者可能不同）
+	CollisionComponent->ClearMoveIgnoreActors();
+	CollisionComponent->IgnoreActorWhenMoving(GetInstigator(), true);
 
 	// 清除所有定时器
 	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
@@ -108,28 +111,61 @@ void ASDTABullet::ActivateBullet(const FVector& Direction)
 	// 重新设置生命周期定时器
 	GetWorld()->GetTimerManager().SetTimer(LifetimeTimer, this, &ASDTABullet::OnLifetimeEnd, GetBulletLifetime(), false);
 
-	// 设置弹丸移动方向
+	// 设置弹丸移动方向并启动移动
 	if (ProjectileMovement)
 	{
+		ProjectileMovement->SetUpdatedComponent(CollisionComponent);
 		ProjectileMovement->Velocity = Direction * GetBulletVelocity();
+		ProjectileMovement->Activate(true);
 	}
 
-	// 启用碰撞
+	// 启用碰撞（此时子弹已放置到发射位置）
 	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	SetActorEnableCollision(true);
 }
 
-void ASDTABullet::ResetBulletState()
+void ASDTABullet::OnAcquiredFromPool(const FSDTAPoolHandle& Handle)
 {
-	// 重置碰撞状态
 	bHit = false;
-	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 
+	// 清除所有定时器（生命周期定时器由ActivateBullet重新设置）
+	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
+	GetWorld()->GetTimerManager().ClearTimer(LifetimeTimer);
+
+	// 恢复可见性和Tick；碰撞保持关闭，子弹仍在对象池的停放位置，
+	// 放置到发射位置后由AcquireBullet或ActivateBullet开启
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+}
+
+void ASDTABullet::OnReleasedToPool()
+{
 	// 清除所有定时器
 	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
 	GetWorld()->GetTimerManager().ClearTimer(LifetimeTimer);
 
-	// 重新设置生命周期定时器
-	GetWorld()->GetTimerManager().SetTimer(LifetimeTimer, this, &ASDTABullet::OnLifetimeEnd, GetBulletLifetime(), false);
+	// 停止弹丸移动，避免回收后在原点继续飞行
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+}
+
+void ASDTABullet::ReturnToPool()
+{
+	// 通过对象池写入的句柄回收，非池化子弹或没有对象池时直接销毁
+	USDTAPoolManager* PoolManager = USDTAPoolManager::Get(this);
+	if (PoolManager && PoolManager->ReleaseObject(GetPoolHandle()))
+	{
+		return;
+	}
+
+	// 重复回收时句柄已过期，子弹仍在池中，不能销毁
+	if (!PoolManager || !PoolManager->OwnsObject(this))
+	{
+		Destroy();
+	}
 }
 
 void ASDTABullet::ExplosionCheck(const FVector& ExplosionCenter)
@@ -208,12 +244,12 @@ void ASDTABullet::ProcessHit(AActor* HitActor, UPrimitiveComponent* HitComp, con
 
 void ASDTABullet::OnDeferredDestruction()
 {
-	Destroy();
+	ReturnToPool();
 }
 
 void ASDTABullet::OnLifetimeEnd()
 {
-	Destroy();	// 这里本应该集成对象池，但是为了能稳定运行，暂时不集成
+	ReturnToPool();
 }
 
 void ASDTABullet::SetBulletDamage(float NewDamage)
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "SDTAWeaponTypes.h"
+#include "Variant_SDTA/Core/Pool/SDTAPoolableInterface.h"
 #include "SDTABullet.generated.h"
 
 class USphereComponent;
@@ -10,7 +11,7 @@ class UProjectileMovementComponent;
 class UPrimitiveComponent;
 
 UCLASS(abstract)
-class SEVENDAYSTOALIVE_API ASDTABullet : public AActor
+class SEVENDAYSTOALIVE_API ASDTABullet : public AActor, public ISDTAPoolable
 {
 	GENERATED_BODY()
 	
@@ -95,6 +96,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Bullet")
 	void ActivateBullet(const FVector& Direction);
 
+	/** ISDTAPoolable：从对象池借出时重置子弹状态，碰撞在放置到发射位置后才开启 */
+	virtual void OnAcquiredFromPool(const FSDTAPoolHandle& Handle) override;
+
+	/** ISDTAPoolable：回收到对象池时停止子弹运动和定时器 */
+	virtual void OnReleasedToPool() override;
+
+	/** 回收到对象池，非池化子弹直接销毁（命中、生命周期结束或外部系统提前结束子弹时调用） */
+	void ReturnToPool();
+
 protected:
 
 	/** 爆炸检查 */
@@ -113,12 +123,6 @@ protected:
 	/** 生命周期结束 */
 	void OnLifetimeEnd();
 
-	/** 重置子弹状态 */
-	void ResetBulletState();
-
-	/** 回收到对象池 */
-	void ReturnToPool();
-
 public:
 
 	/** 设置子弹伤害 */
@@ -5,6 +5,7 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
+#include "Variant_SDTA/Core/Game/SDTAGameMode.h"
 
 // Sets default values
 ASDTAWeapon::ASDTAWeapon()
@@ -185,7 +186,9 @@ void ASDTAWeapon::Fire()
 // 发射实体子弹
 void ASDTAWeapon::FireProjectile()
 {
-	if (!BulletClass || !WeaponOwner)
+	// 优先使用数据表中配置的子弹类，未配置时回退到旧的BulletClass属性
+	TSubclassOf<ASDTABullet> ProjectileClass = WeaponDataRow.BulletClass ? WeaponDataRow.BulletClass : BulletClass;
+	if (!ProjectileClass || !WeaponOwner)
 	{
 		return;
 	}
@@ -198,8 +201,21 @@ void ASDTAWeapon::FireProjectile()
 	FVector TargetLocation = ISDTAWeaponHolder::Execute_GetWeaponTargetLocation(WeaponOwner.GetObject());
 	FRotator FireRotation = (TargetLocation - MuzzleLocation).Rotation();
 
-	// 生成子弹
-	ASDTABullet* Bullet = GetWorld()->SpawnActor<ASDTABullet>(BulletClass, MuzzleLocation, FireRotation);
+	// 从GameMode的子弹对象池获取子弹（无GameMode时直接生成）
+	APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	ASDTABullet* Bullet = nullptr;
+	if (ASDTAGameMode* GameMode = GetWorld()->GetAuthGameMode<ASDTAGameMode>())
+	{
+		Bullet = GameMode->AcquireBullet(ProjectileClass, MuzzleLocation, FireRotation, GetOwner(), OwnerPawn);
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = GetOwner();
+		SpawnParams.Instigator = OwnerPawn;
+		Bullet = GetWorld()->SpawnActor<ASDTABullet>(ProjectileClass, MuzzleLocation, FireRotation, SpawnParams);
+	}
+
 	if (Bullet)
 	{
 		// 设置子弹属性